@@ -0,0 +1,471 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "s21_band_matrix.h"
+#include "s21_buffer_pool.h"
+#include "s21_cholesky.h"
+#include "s21_kernels.h"
+#include "s21_lu.h"
+#include "s21_matrix_oop.h"
+#include "s21_packed_matrix.h"
+#include "s21_qr.h"
+#include "s21_sparse_matrix.h"
+#include "s21_thread_pool.h"
+
+// Runs body until at least min_seconds have passed and returns the average
+// time of one run in seconds
+template <typename Body>
+static double TimeIt(Body body, double min_seconds = 0.2) {
+  using Clock = std::chrono::steady_clock;
+  long runs = 0, batch = 1;
+  Clock::time_point start = Clock::now();
+  double elapsed = 0.0;
+  do {
+    for (long i = 0; i != batch; ++i) body();
+    runs += batch;
+    batch *= 2;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < min_seconds);
+  return elapsed / runs;
+}
+
+static S21Matrix Filled(int rows, int cols) {
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i != rows; ++i) {
+    for (int j = 0; j != cols; ++j) {
+      matrix(i, j) = ((i * 31 + j * 17) % 23) / 11.0 - 1.0;
+    }
+  }
+  return matrix;
+}
+
+// The i-j-k loop MulMatrix used before blocking, kept as the baseline
+static void ReferenceGemm(const std::vector<double> &a,
+                          const std::vector<double> &b, std::vector<double> &c,
+                          int n) {
+  for (int i = 0; i != n; ++i) {
+    for (int j = 0; j != n; ++j) {
+      double sum = 0.0;
+      for (int k = 0; k != n; ++k) sum += a[i * n + k] * b[k * n + j];
+      c[i * n + j] = sum;
+    }
+  }
+}
+
+static void BenchGemm(int max_size) {
+  std::cout << "Square matrix product, GFLOP/s, "
+            << S21ActiveKernels().name << " kernels" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "reference"
+            << std::setw(14) << "MulMatrix" << std::endl;
+  for (int n = 64; n <= max_size; n *= 2) {
+    const S21Matrix a = Filled(n, n), b = Filled(n, n);
+    std::vector<double> ra(n * n), rb(n * n), rc(n * n);
+    for (int i = 0; i != n; ++i) {
+      for (int j = 0; j != n; ++j) {
+        ra[i * n + j] = a(i, j);
+        rb[i * n + j] = b(i, j);
+      }
+    }
+    const double flops = 2.0 * n * n * n;
+    double reference = TimeIt([&] { ReferenceGemm(ra, rb, rc, n); });
+    double library = TimeIt([&] {
+      S21Matrix c(a);
+      c.MulMatrix(b);
+    });
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(2)
+              << std::setw(14) << flops / reference * 1e-9 << std::setw(14)
+              << flops / library * 1e-9 << std::endl;
+  }
+}
+
+static void BenchElementwise(int max_size) {
+  std::cout << "Element-wise operations, GB/s streamed, "
+            << S21ActiveKernels().name << " kernels" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "SumMatrix"
+            << std::setw(14) << "MulNumber" << std::endl;
+  for (int n = 64; n <= max_size; n *= 2) {
+    S21Matrix a = Filled(n, n);
+    const S21Matrix b = Filled(n, n);
+    const double bytes = 8.0 * n * n;
+    double sum = TimeIt([&] { a.SumMatrix(b); });
+    double scale = TimeIt([&] { a.MulNumber(0.5); });
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(2)
+              << std::setw(14) << 3 * bytes / sum * 1e-9 << std::setw(14)
+              << 2 * bytes / scale * 1e-9 << std::endl;
+  }
+}
+
+static void BenchThreads(int max_size) {
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  const int threads = pool.GetThreads();
+  std::cout << "Square matrix product by thread count, GFLOP/s" << std::endl;
+  std::cout << std::setw(8) << "n";
+  for (int t = 1; t <= threads; t *= 2) std::cout << std::setw(10) << t;
+  std::cout << std::endl;
+  for (int n = 256; n <= max_size; n *= 2) {
+    const S21Matrix a = Filled(n, n), b = Filled(n, n);
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(2);
+    for (int t = 1; t <= threads; t *= 2) {
+      double seconds = TimeIt([&] {
+        S21Matrix c(a);
+        c.MulMatrix(b, t);
+      });
+      std::cout << std::setw(10) << 2.0 * n * n * n / seconds * 1e-9;
+    }
+    std::cout << std::endl;
+  }
+}
+
+static void BenchExpressions(int max_size) {
+  std::cout << "a + b - c * 2.0, GB/s of operands read" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "step by step"
+            << std::setw(14) << "fused" << std::endl;
+  for (int n = 64; n <= max_size; n *= 2) {
+    const S21Matrix a = Filled(n, n), b = Filled(n, n), c = Filled(n, n);
+    S21Matrix result(n, n);
+    const double bytes = 3 * 8.0 * n * n;
+    double eager = TimeIt([&] {
+      S21Matrix sum(a);
+      sum.SumMatrix(b);
+      S21Matrix scaled(c);
+      scaled.MulNumber(2.0);
+      sum.SubMatrix(scaled);
+      result = sum;
+    });
+    double fused = TimeIt([&] { result = a + b - c * 2.0; });
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(2)
+              << std::setw(14) << bytes / eager * 1e-9 << std::setw(14)
+              << bytes / fused * 1e-9 << std::endl;
+  }
+}
+
+static void BenchTranspose(int max_size) {
+  std::cout << "Transpose, GB/s of elements read, and a^T * b, GFLOP/s"
+            << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "(i, j) loop"
+            << std::setw(14) << "blocked" << std::setw(14) << "in place"
+            << std::setw(14) << "copy, mul" << std::setw(14) << "lazy"
+            << std::endl;
+  for (int n = 64; n <= max_size; n *= 2) {
+    const S21Matrix a = Filled(n, n), b = Filled(n, n);
+    S21Matrix result(n, n), square = Filled(n, n);
+    const double bytes = 8.0 * n * n, flops = 2.0 * n * n * n;
+    double naive = TimeIt([&] {
+      for (int i = 0; i != n; ++i) {
+        for (int j = 0; j != n; ++j) result(j, i) = a(i, j);
+      }
+    });
+    double blocked = TimeIt([&] { result = a.Transposed().Transpose(); });
+    double inPlace = TimeIt([&] { square.TransposeInPlace(); });
+    double copied = TimeIt([&] {
+      S21Matrix transposed = S21Matrix(a).Transpose();
+      result = transposed * b;
+    });
+    double lazy = TimeIt([&] { result = a.Transposed() * b; });
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(2)
+              << std::setw(14) << bytes / naive * 1e-9 << std::setw(14)
+              << bytes / blocked * 1e-9 << std::setw(14)
+              << bytes / inPlace * 1e-9 << std::setw(14)
+              << flops / copied * 1e-9 << std::setw(14) << flops / lazy * 1e-9
+              << std::endl;
+  }
+}
+
+// Cofactor expansion with a freshly allocated minor per element, the way
+// small determinants and complements were computed before the closed forms
+static S21Matrix ReferenceMinor(const S21Matrix &m, int row, int col) {
+  S21Matrix minor(m.GetRows() - 1, m.GetCols() - 1);
+  for (int i = 0, mi = 0; i != m.GetRows(); ++i) {
+    if (i == row) continue;
+    for (int j = 0, mj = 0; j != m.GetCols(); ++j) {
+      if (j != col) minor(mi, mj++) = m(i, j);
+    }
+    ++mi;
+  }
+  return minor;
+}
+
+static double ReferenceDeterminant(const S21Matrix &m) {
+  double det = m(0, 0);
+  if (m.GetRows() == 2) {
+    det = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+  } else if (m.GetRows() > 2) {
+    det = 0.0;
+    for (int j = 0; j != m.GetCols(); ++j) {
+      det += m(0, j) * std::pow(-1, j) *
+             ReferenceDeterminant(ReferenceMinor(m, 0, j));
+    }
+  }
+  return det;
+}
+
+static S21Matrix ReferenceComplements(const S21Matrix &m) {
+  S21Matrix result(m.GetRows(), m.GetCols());
+  for (int i = 0; i != m.GetRows(); ++i) {
+    for (int j = 0; j != m.GetCols(); ++j) {
+      result(i, j) =
+          std::pow(-1, i + j) * ReferenceDeterminant(ReferenceMinor(m, i, j));
+    }
+  }
+  return result;
+}
+
+static void BenchSmall() {
+  std::cout << "Small matrices, ns/op (cofactor reference / library)"
+            << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(20) << "Determinant"
+            << std::setw(20) << "CalcComplements" << std::setw(20)
+            << "InverseMatrix" << std::endl;
+  for (int n = 2; n <= 4; ++n) {
+    S21Matrix a = Filled(n, n);
+    for (int i = 0; i != n; ++i) a(i, i) += n;
+    volatile double sink = 0.0;
+    double det[2] = {TimeIt([&] { sink = sink + ReferenceDeterminant(a); }),
+                     TimeIt([&] { sink = sink + a.Determinant(); })};
+    double comp[2] = {
+        TimeIt([&] { sink = sink + ReferenceComplements(a)(0, 0); }),
+        TimeIt([&] { sink = sink + a.CalcComplements()(0, 0); })};
+    double inv[2] = {TimeIt([&] {
+                       S21Matrix result = ReferenceComplements(a).Transpose();
+                       result *= 1.0 / ReferenceDeterminant(a);
+                       sink = sink + result(0, 0);
+                     }),
+                     TimeIt([&] { sink = sink + a.InverseMatrix()(0, 0); })};
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(1);
+    for (double *times : {det, comp, inv}) {
+      std::cout << std::setw(10) << times[0] * 1e9 << std::setw(10)
+                << times[1] * 1e9;
+    }
+    std::cout << std::endl;
+  }
+}
+
+// Product of an n x n matrix with about 8 nonzeros per row and a dense
+// n x 64 one, dense and sparse
+static void BenchSparse(int max_size) {
+  std::cout << "sparse (8 per row) * dense (64 columns), ms" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(10) << "nnz" << std::setw(14)
+            << "dense" << std::setw(14) << "csr" << std::setw(14) << "csc"
+            << std::endl;
+  for (int n = 256; n <= max_size; n *= 2) {
+    std::vector<S21SparseMatrix::Triplet> triplets;
+    for (int i = 0; i != n; ++i) {
+      for (int k = 0; k != 8; ++k) {
+        triplets.push_back({i, (i * 7 + k * 131) % n, 1.0 + k});
+      }
+    }
+    const S21SparseMatrix csr(n, n, triplets);
+    const S21SparseMatrix csc = csr.ToFormat(S21SparseFormat::kCSC);
+    const S21Matrix a = csr.ToDense(), b = Filled(n, 64);
+    S21Matrix result;
+    double dense = TimeIt([&] { result = a * b; });
+    double rows = TimeIt([&] { result = csr * b; });
+    double cols = TimeIt([&] { result = csc * b; });
+    std::cout << std::setw(8) << n << std::setw(10) << csr.GetNonZeros()
+              << std::fixed << std::setprecision(3) << std::setw(14)
+              << dense * 1e3 << std::setw(14) << rows * 1e3 << std::setw(14)
+              << cols * 1e3 << std::endl;
+  }
+}
+
+// Gram matrix A^T * A and a lower triangular times a dense n x n matrix,
+// general and packed
+static void BenchPacked(int max_size) {
+  std::cout << "packed storage, ms" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "a^T * a"
+            << std::setw(14) << "Gram" << std::setw(14) << "dense * b"
+            << std::setw(14) << "tri * b" << std::endl;
+  for (int n = 128; n <= max_size; n *= 2) {
+    const S21Matrix a = Filled(n, n), b = Filled(n, n);
+    const S21TriangularMatrix lower(a, S21Triangle::kLower);
+    const S21Matrix lowerDense = lower.ToDense();
+    S21Matrix result;
+    S21SymmetricMatrix gram;
+    double general = TimeIt([&] { result = a.Transposed() * a; });
+    double packed = TimeIt([&] { gram = S21SymmetricMatrix::Gram(a); });
+    double dense = TimeIt([&] { result = lowerDense * b; });
+    double triangular = TimeIt([&] { result = lower * b; });
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(3)
+              << std::setw(14) << general * 1e3 << std::setw(14)
+              << packed * 1e3 << std::setw(14) << dense * 1e3 << std::setw(14)
+              << triangular * 1e3 << std::endl;
+  }
+}
+
+// Tridiagonal system with one right-hand side, through the dense LU and
+// the band LU
+static void BenchBand(int max_size) {
+  std::cout << "tridiagonal solve, ms" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "dense LU"
+            << std::setw(14) << "band LU" << std::endl;
+  for (int n = 128; n <= max_size; n *= 2) {
+    const std::vector<double> side(n - 1, -1.0), diagonal(n, 2.0);
+    const S21BandMatrix band = S21BandMatrix::Tridiagonal(side, diagonal, side);
+    const S21Matrix dense = band.ToDense(), b = Filled(n, 1);
+    S21Matrix x;
+    double full = TimeIt([&] { x = S21LU(dense).Solve(b); });
+    double banded = TimeIt([&] { x = band.Solve(b); });
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(3)
+              << std::setw(14) << full * 1e3 << std::setw(14) << banded * 1e3
+              << std::endl;
+  }
+}
+
+// Factorization of a symmetric positive definite matrix, LU and Cholesky
+static void BenchCholesky(int max_size) {
+  std::cout << "factorization of an SPD matrix, ms" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "LU" << std::setw(14)
+            << "Cholesky" << std::endl;
+  for (int n = 128; n <= max_size; n *= 2) {
+    const S21Matrix a = Filled(n, n);
+    S21Matrix spd = a.Transposed() * a;
+    for (int i = 0; i != n; ++i) spd(i, i) += n;
+    double lu = TimeIt([&] { S21LU factors(spd); });
+    double cholesky = TimeIt([&] { S21Cholesky factors(spd); });
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(3)
+              << std::setw(14) << lu * 1e3 << std::setw(14) << cholesky * 1e3
+              << std::endl;
+  }
+}
+
+// Least squares for a tall n x 64 matrix, through the normal equations as
+// InverseMatrix(A^T * A) * A^T * b and through QR
+static void BenchLeastSquares(int max_size) {
+  std::cout << "least squares, n x 64, ms" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "normal eq."
+            << std::setw(14) << "QR" << std::endl;
+  for (int n = 256; n <= max_size * 8; n *= 2) {
+    S21Matrix a = Filled(n, 64);
+    for (int i = 0; i != 64; ++i) a(i, i) += 10;
+    const S21Matrix b = Filled(n, 1);
+    S21Matrix x;
+    double normal = TimeIt([&] {
+      S21Matrix at = a.Transpose();
+      x = (at * a).InverseMatrix() * at * b;
+    });
+    double qr = TimeIt([&] { x = S21QR::LeastSquares(a, b); });
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(3)
+              << std::setw(14) << normal * 1e3 << std::setw(14) << qr * 1e3
+              << std::endl;
+  }
+}
+
+// A request that builds two n x n temporaries and drops them, with
+// operator new and delete and with the buffer pool
+static void BenchPool(int max_size) {
+  std::cout << "n x n temporaries, ns per request (new/delete / pool)"
+            << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "new/delete"
+            << std::setw(14) << "pool" << std::endl;
+  S21BufferPool &pool = S21BufferPool::Instance();
+  for (int n = 8; n <= std::min(max_size, 512); n *= 2) {
+    const S21Matrix a = Filled(n, n), b = Filled(n, n);
+    volatile double sink = 0.0;
+    auto request = [&] {
+      S21Matrix sum = a + b;
+      S21Matrix scaled(n, n);
+      scaled(n - 1, n - 1) = sum(0, 0);
+      sink = sink + scaled(n - 1, n - 1);
+    };
+    const double plain = TimeIt(request);
+    pool.SetEnabled(true);
+    const double pooled = TimeIt(request);
+    pool.SetEnabled(false);
+    pool.Trim();
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(1)
+              << std::setw(14) << plain * 1e9 << std::setw(14)
+              << pooled * 1e9 << std::endl;
+  }
+}
+
+// A user loop that writes a(i, j) = 2 * b(i, j) + i through each kind of
+// element access
+static void BenchAccess(int max_size) {
+  std::cout << "Element loop, ns per element" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "operator()"
+            << std::setw(14) << "At" << std::setw(14) << "Row"
+            << std::setw(14) << "transform" << std::endl;
+  for (int n = 64; n <= max_size; n *= 2) {
+    S21Matrix a(n, n);
+    const S21Matrix b = Filled(n, n);
+    const double checked = TimeIt([&] {
+      for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) a(i, j) = 2 * b(i, j) + i;
+    });
+    const double unchecked = TimeIt([&] {
+      for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) a.At(i, j) = 2 * b.At(i, j) + i;
+    });
+    const double rows = TimeIt([&] {
+      for (int i = 0; i < n; i++) {
+        S21Span<double> row = a.Row(i);
+        S21Span<const double> src = b.Row(i);
+        for (int j = 0; j < n; j++) row[j] = 2 * src[j] + i;
+      }
+    });
+    const double transform = TimeIt([&] {
+      for (int i = 0; i < n; i++) {
+        std::transform(b.Row(i).begin(), b.Row(i).end(), a.Row(i).begin(),
+                       [i](double x) { return 2 * x + i; });
+      }
+    });
+    const double elements = 1e-9 * n * n;
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(3)
+              << std::setw(14) << checked / elements << std::setw(14)
+              << unchecked / elements << std::setw(14) << rows / elements
+              << std::setw(14) << transform / elements << std::endl;
+  }
+}
+
+// Copies of an n x n matrix that are read and dropped, deep and shared
+static void BenchCopyOnWrite(int max_size) {
+  std::cout << "n x n copies, ns per copy (deep / shared)" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "deep"
+            << std::setw(14) << "shared" << std::endl;
+  for (int n = 8; n <= std::min(max_size, 1024); n *= 2) {
+    S21Matrix a = Filled(n, n);
+    volatile double sink = 0.0;
+    auto copy = [&] {
+      const S21Matrix b = a;
+      sink = sink + b(n - 1, n - 1);
+    };
+    const double deep = TimeIt(copy);
+    a.SetCopyOnWrite(true);
+    const double shared = TimeIt(copy);
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(1)
+              << std::setw(14) << deep * 1e9 << std::setw(14)
+              << shared * 1e9 << std::endl;
+  }
+}
+
+// Usage: ./benchmark [suite] [max_size]
+int main(int argc, char **argv) {
+  const char *suite = argc > 1 ? argv[1] : "all";
+  const int max_size = argc > 2 ? std::atoi(argv[2]) : 2048;
+  bool all = std::strcmp(suite, "all") == 0;
+  if (all || std::strcmp(suite, "small") == 0) BenchSmall();
+  if (all || std::strcmp(suite, "gemm") == 0) BenchGemm(max_size);
+  if (all || std::strcmp(suite, "threads") == 0) BenchThreads(max_size);
+  if (all || std::strcmp(suite, "elementwise") == 0) {
+    BenchElementwise(max_size);
+  }
+  if (all || std::strcmp(suite, "expressions") == 0) {
+    BenchExpressions(max_size);
+  }
+  if (all || std::strcmp(suite, "transpose") == 0) BenchTranspose(max_size);
+  if (all || std::strcmp(suite, "sparse") == 0) BenchSparse(max_size);
+  if (all || std::strcmp(suite, "packed") == 0) BenchPacked(max_size);
+  if (all || std::strcmp(suite, "band") == 0) BenchBand(max_size);
+  if (all || std::strcmp(suite, "cholesky") == 0) BenchCholesky(max_size);
+  if (all || std::strcmp(suite, "lstsq") == 0) BenchLeastSquares(max_size);
+  if (all || std::strcmp(suite, "pool") == 0) BenchPool(max_size);
+  if (all || std::strcmp(suite, "cow") == 0) BenchCopyOnWrite(max_size);
+  if (all || std::strcmp(suite, "access") == 0) BenchAccess(max_size);
+  return 0;
+}
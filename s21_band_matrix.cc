@@ -0,0 +1,282 @@
+#include "s21_band_matrix.h"
+
+#include "s21_kernels.h"
+
+template <typename T>
+S21BasicBandMatrix<T>::S21BasicBandMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper) {
+  if (size < 1) {
+    throw std::invalid_argument(
+        "There should be more than 1 row and/or column.");
+  }
+  if (lower < 0 || upper < 0)
+    throw std::invalid_argument("Bandwidths cannot be less than 0.");
+  data_.assign(static_cast<size_t>(size) * Width(), 0);
+}
+
+template <typename T>
+S21BasicBandMatrix<T>::S21BasicBandMatrix(const S21BasicMatrixView<T> &dense,
+                                          int lower, int upper)
+    : S21BasicBandMatrix(dense.GetRows(), lower, upper) {
+  if (dense.GetRows() != dense.GetCols())
+    throw std::invalid_argument("Matrix must be square.");
+  for (int i = 0; i != size_; ++i) {
+    const int first = std::max(0, i - lower_);
+    const int last = std::min(size_ - 1, i + upper_);
+    for (int j = first; j <= last; ++j) {
+      data_[i * Width() + j - i + lower_] = dense.Coeff(i, j);
+    }
+  }
+}
+
+template <typename T>
+S21BasicBandMatrix<T> S21BasicBandMatrix<T>::Tridiagonal(
+    const std::vector<T> &sub, const std::vector<T> &diagonal,
+    const std::vector<T> &super) {
+  const int size = static_cast<int>(diagonal.size());
+  if (sub.size() + 1 != diagonal.size() || super.size() + 1 != diagonal.size())
+    throw std::invalid_argument("Wrong sizes of the diagonals.");
+  S21BasicBandMatrix result(size, 1, 1);
+  for (int i = 0; i != size; ++i) {
+    T *row = result.data_.data() + i * 3;
+    if (i != 0) row[0] = sub[i - 1];
+    row[1] = diagonal[i];
+    if (i != size - 1) row[2] = super[i];
+  }
+  return result;
+}
+
+template <typename T>
+int S21BasicBandMatrix<T>::GetSize() const { return size_; }
+
+template <typename T>
+int S21BasicBandMatrix<T>::GetLower() const { return lower_; }
+
+template <typename T>
+int S21BasicBandMatrix<T>::GetUpper() const { return upper_; }
+
+template <typename T>
+S21BasicMatrix<T> S21BasicBandMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(size_, size_);
+  for (int i = 0; i != size_; ++i) {
+    const int first = std::max(0, i - lower_);
+    const int last = std::min(size_ - 1, i + upper_);
+    const T *src = data_.data() + i * Width() - i + lower_;
+    std::copy(src + first, src + last + 1,
+              result.matrix_ + i * result.stride_ + first);
+  }
+  return result;
+}
+
+// Bands of different widths are compared element by element
+template <typename T>
+bool S21BasicBandMatrix<T>::EqMatrix(const S21BasicBandMatrix &other) const {
+  if (size_ != other.size_) return false;
+  const int lower = std::max(lower_, other.lower_);
+  const int upper = std::max(upper_, other.upper_);
+  for (int i = 0; i != size_; ++i) {
+    const int last = std::min(size_ - 1, i + upper);
+    for (int j = std::max(0, i - lower); j <= last; ++j) {
+      const T a = InBand(i, j) ? data_[i * Width() + j - i + lower_] : 0;
+      const T b = other.InBand(i, j)
+                      ? other.data_[i * other.Width() + j - i + other.lower_]
+                      : 0;
+      if (std::abs(a - b) >= S21Tolerance<T>::kValue) return false;
+    }
+  }
+  return true;
+}
+
+// Row i of the product adds the rows of the dense operand under the band
+// of row i, each scaled by its element
+template <typename T>
+S21BasicMatrix<T> S21BasicBandMatrix<T>::MulDense(
+    const S21BasicMatrixView<T> &dense) const {
+  S21BasicMatrix<T> result = S21BasicMatrix<T>();
+  try {
+    if (size_ != dense.GetRows())
+      throw std::invalid_argument("Wrong matrices sizes for multiplication.");
+    if (!dense.IsBlock() || dense.IsTransposed())
+      return MulDense(S21BasicMatrix<T>(dense));
+    const int m = dense.GetCols(), bs = dense.GetStride();
+    result = S21BasicMatrix<T>(size_, m);
+    for (int i = 0; i != size_; ++i) {
+      const int first = std::max(0, i - lower_);
+      const int last = std::min(size_ - 1, i + upper_);
+      const T *row = data_.data() + i * Width() - i + lower_;
+      T *dst = result.matrix_ + i * result.stride_;
+      for (int j = first; j <= last; ++j) {
+        if (row[j] != 0) {
+          S21TypedKernels<T>::Axpy(m, row[j], dense.GetData() + j * bs, dst);
+        }
+      }
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+    result.DeleteMatrix();
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicBandMatrix<T>::Solve(
+    const S21BasicMatrixView<T> &b) const {
+  return S21BasicBandLU<T>(*this).Solve(b);
+}
+
+template <typename T>
+T S21BasicBandMatrix<T>::Determinant() const {
+  return S21BasicBandLU<T>(*this).Determinant();
+}
+
+template <typename T>
+bool S21BasicBandMatrix<T>::operator==(const S21BasicBandMatrix &other) const {
+  return EqMatrix(other);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicBandMatrix<T>::operator*(
+    const S21BasicMatrixView<T> &dense) const {
+  return MulDense(dense);
+}
+
+template <typename T>
+T &S21BasicBandMatrix<T>::operator()(int row, int col) {
+  CheckIndices(row, col);
+  if (!InBand(row, col))
+    throw std::invalid_argument("The element is outside the band.");
+  return data_[row * Width() + col - row + lower_];
+}
+
+template <typename T>
+T S21BasicBandMatrix<T>::operator()(int row, int col) const {
+  CheckIndices(row, col);
+  return InBand(row, col) ? data_[row * Width() + col - row + lower_] : 0;
+}
+
+template <typename T>
+bool S21BasicBandMatrix<T>::InBand(int row, int col) const {
+  return col - row >= -lower_ && col - row <= upper_;
+}
+
+template <typename T>
+void S21BasicBandMatrix<T>::CheckIndices(int row, int col) const {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_)
+    throw std::invalid_argument("The element is outside the matrix.");
+}
+
+// Gaussian elimination with the pivot chosen among the lower_ rows below
+// the diagonal, the only ones with a nonzero in the column. A column without
+// a nonzero pivot is skipped so that U gets a zero on its diagonal, a pivot
+// within the tolerance marks the matrix singular
+template <typename T>
+S21BasicBandLU<T>::S21BasicBandLU(const S21BasicBandMatrix<T> &matrix)
+    : size_(matrix.size_),
+      lower_(matrix.lower_),
+      upper_(matrix.upper_),
+      u_(static_cast<size_t>(size_) * Width(), 0),
+      l_(static_cast<size_t>(size_) * lower_, 0),
+      perm_(size_),
+      sign_(1),
+      singular_(false) {
+  const int w = Width(), n = size_;
+  for (int i = 0; i != n; ++i) {
+    std::copy(matrix.data_.begin() + i * matrix.Width(),
+              matrix.data_.begin() + (i + 1) * matrix.Width(),
+              u_.begin() + i * w);
+  }
+  // Element (i, j) of the working band
+  auto at = [&](int i, int j) -> T & { return u_[i * w + j - i + lower_]; };
+  for (int k = 0; k != n; ++k) {
+    const int lastRow = std::min(n - 1, k + lower_);
+    const int lastCol = std::min(n - 1, k + lower_ + upper_);
+    int pivot = k;
+    for (int i = k + 1; i <= lastRow; ++i) {
+      if (std::abs(at(i, k)) > std::abs(at(pivot, k))) pivot = i;
+    }
+    perm_[k] = pivot;
+    // The same rule as the dense LU: a pivot within the tolerance makes the
+    // matrix singular, only an exact zero leaves the column as it is
+    if (std::abs(at(pivot, k)) <= S21Tolerance<T>::kValue) singular_ = true;
+    if (at(pivot, k) == 0) continue;
+    if (pivot != k) {
+      sign_ = -sign_;
+      for (int j = k; j <= lastCol; ++j) std::swap(at(k, j), at(pivot, j));
+    }
+    for (int i = k + 1; i <= lastRow; ++i) {
+      const T factor = at(i, k) / at(k, k);
+      l_[k * lower_ + i - k - 1] = factor;
+      at(i, k) = 0;
+      if (factor != 0) {
+        S21TypedKernels<T>::Axpy(lastCol - k, -factor, &at(k, k + 1),
+                                 &at(i, k + 1));
+      }
+    }
+  }
+}
+
+template <typename T>
+int S21BasicBandLU<T>::GetSize() const { return size_; }
+
+template <typename T>
+bool S21BasicBandLU<T>::IsSingular() const { return singular_; }
+
+// Replays the row swaps and eliminations on B, then back substitution with
+// U, O(n * (lower + upper)) per right-hand side
+template <typename T>
+S21BasicMatrix<T> S21BasicBandLU<T>::Solve(
+    const S21BasicMatrixView<T> &b) const {
+  const int n = size_, w = Width();
+  S21BasicMatrix<T> x = S21BasicMatrix<T>();
+  try {
+    if (b.GetRows() != n)
+      throw std::invalid_argument("Wrong matrices sizes for solving.");
+    if (singular_)
+      throw std::invalid_argument("Cannot solve a system with 0 determinant.");
+    x = b;
+    const int m = x.cols_, xs = x.stride_;
+    for (int k = 0; k != n; ++k) {
+      T *rowK = x.matrix_ + k * xs;
+      if (perm_[k] != k) {
+        std::swap_ranges(rowK, rowK + m, x.matrix_ + perm_[k] * xs);
+      }
+      const int lastRow = std::min(n - 1, k + lower_);
+      for (int i = k + 1; i <= lastRow; ++i) {
+        const T factor = l_[k * lower_ + i - k - 1];
+        if (factor != 0) {
+          S21TypedKernels<T>::Axpy(m, -factor, rowK, x.matrix_ + i * xs);
+        }
+      }
+    }
+    for (int i = n - 1; i >= 0; --i) {
+      const T *row = u_.data() + i * w - i + lower_;
+      T *rowI = x.matrix_ + i * xs;
+      const int lastCol = std::min(n - 1, i + lower_ + upper_);
+      for (int j = i + 1; j <= lastCol; ++j) {
+        if (row[j] != 0) {
+          S21TypedKernels<T>::Axpy(m, -row[j], x.matrix_ + j * xs, rowI);
+        }
+      }
+      S21TypedKernels<T>::Scale(m, 1 / row[i], rowI);
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+    x.DeleteMatrix();
+  }
+  return x;
+}
+
+template <typename T>
+T S21BasicBandLU<T>::Determinant() const {
+  if (singular_) return 0;
+  T det = sign_;
+  for (int i = 0; i != size_; ++i) det *= u_[i * Width() + lower_];
+  return det;
+}
+
+template class S21BasicBandMatrix<float>;
+template class S21BasicBandMatrix<double>;
+template class S21BasicBandMatrix<long double>;
+template class S21BasicBandLU<float>;
+template class S21BasicBandLU<double>;
+template class S21BasicBandLU<long double>;
@@ -0,0 +1,102 @@
+#ifndef S21_BAND_MATRIX_H
+#define S21_BAND_MATRIX_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+template <typename T>
+class S21BasicBandLU;
+
+// Square matrix whose nonzero elements lie on the diagonal, the lower_
+// diagonals below it and the upper_ diagonals above it. Only the band is
+// stored, n * (lower + upper + 1) elements. Members are defined in
+// s21_band_matrix.cc and instantiated there for float, double and long double
+template <typename T>
+class S21BasicBandMatrix {
+  template <typename>
+  friend class S21BasicBandLU;
+
+ private:
+  // Element (i, j) with -lower_ <= j - i <= upper_ lives at
+  // data_[i * (lower_ + upper_ + 1) + j - i + lower_]
+  int size_, lower_, upper_;
+  std::vector<T> data_;
+  int Width() const { return lower_ + upper_ + 1; }
+  bool InBand(int row, int col) const;
+  void CheckIndices(int row, int col) const;
+
+ public:
+  using value_type = T;
+
+  // A new matrix is filled with zeros. A dense matrix must be square, the
+  // elements outside the band are ignored
+  explicit S21BasicBandMatrix(int size = 1, int lower = 0, int upper = 0);
+  S21BasicBandMatrix(const S21BasicMatrixView<T> &dense, int lower, int upper);
+  // Tridiagonal matrix from its three diagonals, sub and super have one
+  // element less than diagonal
+  static S21BasicBandMatrix Tridiagonal(const std::vector<T> &sub,
+                                        const std::vector<T> &diagonal,
+                                        const std::vector<T> &super);
+
+  int GetSize() const;
+  int GetLower() const;
+  int GetUpper() const;
+  S21BasicMatrix<T> ToDense() const;
+
+  // Operations
+  bool EqMatrix(const S21BasicBandMatrix &other) const;
+  // Band times dense in O(n * (lower + upper + 1)) per column
+  S21BasicMatrix<T> MulDense(const S21BasicMatrixView<T> &dense) const;
+  // Factorize with S21BasicBandLU, keep the factorization to solve several
+  // systems with the same matrix
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T> &b) const;
+  T Determinant() const;
+
+  // Operators
+  bool operator==(const S21BasicBandMatrix &other) const;
+  S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &dense) const;
+  // Only elements of the band can be written, the others read as zero
+  T &operator()(int row, int col);
+  T operator()(int row, int col) const;
+};
+
+// LU factorization of a band matrix with partial pivoting in
+// O(n * lower * (lower + upper)). Row swaps widen U to lower + upper
+// diagonals above the diagonal, the factors stay inside the band
+template <typename T>
+class S21BasicBandLU {
+ private:
+  // Row k of u_ covers columns k - lower_..k + lower_ + upper_, element
+  // (k, j) lives at u_[k * Width() + j - k + lower_] and U is the part from
+  // the diagonal on. l_[k * lower_ + i - k - 1] is the multiple of row k
+  // subtracted from row i after rows k and perm_[k] were swapped
+  int size_, lower_, upper_;
+  std::vector<T> u_;
+  std::vector<T> l_;
+  std::vector<int> perm_;
+  int sign_;
+  bool singular_;
+  int Width() const { return 2 * lower_ + upper_ + 1; }
+
+ public:
+  explicit S21BasicBandLU(const S21BasicBandMatrix<T> &matrix);
+
+  int GetSize() const;
+  bool IsSingular() const;
+
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T> &b) const;
+  T Determinant() const;
+};
+
+using S21BandMatrix = S21BasicBandMatrix<double>;
+using S21BandLU = S21BasicBandLU<double>;
+
+extern template class S21BasicBandMatrix<float>;
+extern template class S21BasicBandMatrix<double>;
+extern template class S21BasicBandMatrix<long double>;
+extern template class S21BasicBandLU<float>;
+extern template class S21BasicBandLU<double>;
+extern template class S21BasicBandLU<long double>;
+
+#endif  // S21_BAND_MATRIX_H
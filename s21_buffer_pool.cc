@@ -0,0 +1,172 @@
+#include "s21_buffer_pool.h"
+
+#include <cstdlib>
+#include <new>
+
+// Classes of 64, 128, 192 and 256 bytes, then four per power of two up to
+// kMaxPooledBytes. A thread keeps up to kThreadBlocks blocks of every class,
+// the shared bins kSharedBlocks more
+static constexpr int kPoolClasses = 76, kThreadBlocks = 8, kSharedBlocks = 32;
+
+static int SizeClass(std::size_t bytes) {
+  if (bytes <= 256) return bytes == 0 ? 0 : static_cast<int>((bytes - 1) / 64);
+  int shift = 8;
+  while ((bytes - 1) >> (shift + 1)) ++shift;
+  const int quarter = static_cast<int>((bytes - 1) >> (shift - 2));
+  return 4 + (shift - 8) * 4 + quarter - 4;
+}
+
+static std::size_t ClassBytes(int index) {
+  if (index < 4) return static_cast<std::size_t>(index + 1) * 64;
+  const int shift = 8 + (index - 4) / 4, quarter = 4 + (index - 4) % 4;
+  return static_cast<std::size_t>(quarter + 1) << (shift - 2);
+}
+
+static void *NewBlock(std::size_t bytes) {
+  return ::operator new(bytes, std::align_val_t(S21BufferPool::kAlignment));
+}
+
+static void DeleteBlock(void *block) noexcept {
+  ::operator delete(block, std::align_val_t(S21BufferPool::kAlignment));
+}
+
+// A slot holds a block or nullptr. Blocks are put in with a compare-exchange
+// from nullptr and taken out with an exchange, so no thread ever reads a
+// block another thread has taken
+static std::atomic<void *> shared_bins[kPoolClasses][kSharedBlocks];
+
+static bool PushShared(int index, void *block) {
+  for (std::atomic<void *> &slot : shared_bins[index]) {
+    void *empty = nullptr;
+    if (!slot.load(std::memory_order_relaxed) &&
+        slot.compare_exchange_strong(empty, block, std::memory_order_release,
+                                     std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void *PopShared(int index) {
+  for (std::atomic<void *> &slot : shared_bins[index]) {
+    if (slot.load(std::memory_order_relaxed)) {
+      void *block = slot.exchange(nullptr, std::memory_order_acquire);
+      if (block) return block;
+    }
+  }
+  return nullptr;
+}
+
+// Blocks cached by one thread, moved to the shared bins when it exits
+struct S21BufferCache {
+  void *blocks[kPoolClasses][kThreadBlocks];
+  int counts[kPoolClasses] = {};
+
+  void *Pop(int index) {
+    return counts[index] ? blocks[index][--counts[index]] : nullptr;
+  }
+  bool Push(int index, void *block) {
+    if (counts[index] == kThreadBlocks) return false;
+    blocks[index][counts[index]++] = block;
+    return true;
+  }
+  ~S21BufferCache();
+};
+
+static thread_local S21BufferCache tls_cache;
+// Set once tls_cache is destroyed, matrices released later by the exiting
+// thread bypass it
+static thread_local bool tls_cache_gone = false;
+// Number of live S21BufferPoolScope objects of the thread
+static thread_local int tls_scopes = 0;
+
+S21BufferCache::~S21BufferCache() {
+  S21BufferPool &pool = S21BufferPool::Instance();
+  for (int index = 0; index != kPoolClasses; ++index) {
+    while (void *block = Pop(index)) {
+      if (!PushShared(index, block)) {
+        DeleteBlock(block);
+        pool.Count(ClassBytes(index), -1);
+      }
+    }
+  }
+  tls_cache_gone = true;
+}
+
+S21BufferPool::S21BufferPool()
+    : enabled_(false),
+      hits_(0),
+      misses_(0),
+      cached_blocks_(0),
+      cached_bytes_(0) {
+  const char *env = std::getenv("S21_MATRIX_POOL");
+  if (env && std::atoi(env) != 0) enabled_ = true;
+}
+
+S21BufferPool &S21BufferPool::Instance() {
+  static S21BufferPool pool;
+  return pool;
+}
+
+void S21BufferPool::SetEnabled(bool enabled) { enabled_ = enabled; }
+
+bool S21BufferPool::IsEnabled() const {
+  return tls_scopes > 0 || enabled_.load(std::memory_order_relaxed);
+}
+
+void *S21BufferPool::Allocate(std::size_t bytes, bool &pooled) {
+  const int index = SizeClass(bytes);
+  // A request of exactly a class size can be cached even if it was made
+  // while the pool was disabled
+  pooled = bytes <= kMaxPooledBytes && bytes == ClassBytes(index);
+  if (bytes > kMaxPooledBytes || !IsEnabled()) return NewBlock(bytes);
+  void *block = tls_cache_gone ? nullptr : tls_cache.Pop(index);
+  if (!block) block = PopShared(index);
+  pooled = true;
+  if (block) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    Count(ClassBytes(index), -1);
+    return block;
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return NewBlock(ClassBytes(index));
+}
+
+void S21BufferPool::Release(void *block, std::size_t bytes,
+                            bool pooled) noexcept {
+  if (pooled && IsEnabled()) {
+    const int index = SizeClass(bytes);
+    if ((!tls_cache_gone && tls_cache.Push(index, block)) ||
+        PushShared(index, block)) {
+      Count(ClassBytes(index), 1);
+      return;
+    }
+  }
+  DeleteBlock(block);
+}
+
+S21BufferPool::Stats S21BufferPool::GetStats() const {
+  return {hits_.load(), misses_.load(), cached_blocks_.load(),
+          cached_bytes_.load()};
+}
+
+void S21BufferPool::Trim() {
+  for (int index = 0; index != kPoolClasses; ++index) {
+    void *block = nullptr;
+    while ((!tls_cache_gone && (block = tls_cache.Pop(index))) ||
+           (block = PopShared(index))) {
+      DeleteBlock(block);
+      Count(ClassBytes(index), -1);
+    }
+  }
+}
+
+void S21BufferPool::Count(std::size_t bytes, int blocks) {
+  cached_blocks_.fetch_add(blocks, std::memory_order_relaxed);
+  cached_bytes_.fetch_add(static_cast<long>(bytes) * blocks,
+                          std::memory_order_relaxed);
+}
+
+S21BufferPoolScope::S21BufferPoolScope() { ++tls_scopes; }
+
+S21BufferPoolScope::~S21BufferPoolScope() { --tls_scopes; }
@@ -0,0 +1,72 @@
+#ifndef S21_BUFFER_POOL_H
+#define S21_BUFFER_POOL_H
+
+#include <atomic>
+#include <cstddef>
+
+struct S21BufferCache;
+
+// Allocator of the heap storage of S21Matrix. Every block is 64-byte aligned.
+// While the pool is enabled, requests are rounded up to a size class,
+// classes grow by a quarter of a power of two, and released blocks are kept
+// for the next request of the same class: first in a small cache of the
+// releasing thread, then in lock-free shared bins. While it is disabled
+// blocks have the requested size and go straight to operator new and
+// delete. Blocks above kMaxPooledBytes are never kept
+class S21BufferPool {
+  friend struct S21BufferCache;
+
+ public:
+  static constexpr std::size_t kAlignment = 64;
+  static constexpr std::size_t kMaxPooledBytes = std::size_t(1) << 26;
+
+  struct Stats {
+    // Requests served from a cache and requests that went to operator new
+    long hits, misses;
+    // Blocks and bytes kept in the shared bins and in the caches of all
+    // threads
+    long cached_blocks, cached_bytes;
+  };
+
+  S21BufferPool(const S21BufferPool &) = delete;
+  S21BufferPool &operator=(const S21BufferPool &) = delete;
+
+  // Pool used by S21Matrix. It starts enabled if S21_MATRIX_POOL is set to
+  // a nonzero number in the environment
+  static S21BufferPool &Instance();
+
+  // Enables or disables the pool for the whole process, S21BufferPoolScope
+  // enables it for one thread
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const;
+
+  // pooled is set when the block has the size of its class and may be
+  // cached once released. Release must get the bytes and pooled of the
+  // call that allocated the block
+  void *Allocate(std::size_t bytes, bool &pooled);
+  void Release(void *block, std::size_t bytes, bool pooled) noexcept;
+
+  Stats GetStats() const;
+  // Returns the blocks of the shared bins and of the calling thread's cache
+  // to operator delete. Caches of other threads go to the shared bins when
+  // those threads exit
+  void Trim();
+
+ private:
+  std::atomic<bool> enabled_;
+  std::atomic<long> hits_, misses_, cached_blocks_, cached_bytes_;
+  S21BufferPool();
+  void Count(std::size_t bytes, int blocks);
+};
+
+// Enables the pool on the current thread until the end of the scope, scopes
+// may nest. Blocks stay cached after the scope, see S21BufferPool::Trim()
+class S21BufferPoolScope {
+ public:
+  S21BufferPoolScope();
+  S21BufferPoolScope(const S21BufferPoolScope &) = delete;
+  S21BufferPoolScope &operator=(const S21BufferPoolScope &) = delete;
+  ~S21BufferPoolScope();
+};
+
+#endif  // S21_BUFFER_POOL_H
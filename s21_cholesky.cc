@@ -0,0 +1,177 @@
+#include "s21_cholesky.h"
+
+#include <limits>
+
+#include "s21_scratch_arena.h"
+
+// Columns factorized together, their update from the columns on the left
+// is a single matrix product
+static constexpr int kCholeskyBlock = 64;
+
+template <typename T>
+S21BasicCholesky<T>::S21BasicCholesky(const S21BasicMatrixView<T> &matrix)
+    : l_(matrix), positive_(true) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::invalid_argument("Matrix must be square.");
+  }
+  Factorize();
+}
+
+template <typename T>
+S21BasicCholesky<T>::S21BasicCholesky(S21BasicMatrix<T> &&matrix)
+    : l_(std::move(matrix)), positive_(true) {
+  if (l_.rows_ != l_.cols_) {
+    throw std::invalid_argument("Matrix must be square.");
+  }
+  l_.Detach();
+  Factorize();
+}
+
+template <typename T>
+int S21BasicCholesky<T>::GetSize() const { return l_.rows_; }
+
+template <typename T>
+bool S21BasicCholesky<T>::IsPositiveDefinite() const { return positive_; }
+
+// Solves L * Y = B row by row, then L^T * X = Y from the last row up: once
+// row i of X is known it is subtracted from the rows above it with row i of
+// L, so both sweeps read L by rows
+template <typename T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Solve(const S21BasicMatrix<T> &b) const {
+  const int n = l_.rows_, m = b.cols_, ls = l_.stride_;
+  S21BasicMatrix<T> x = S21BasicMatrix<T>();
+  try {
+    if (b.rows_ != n)
+      throw std::invalid_argument("Wrong matrices sizes for solving.");
+    if (!positive_)
+      throw std::invalid_argument("Matrix must be positive definite.");
+    x = b;
+    // x is written in place below, it must not share b's elements
+    x.Detach();
+    const int xs = x.stride_;
+    const T *l = l_.matrix_;
+    for (int i = 0; i != n; ++i) {
+      T *rowI = x.matrix_ + i * xs;
+      for (int k = 0; k != i; ++k) {
+        const T factor = l[i * ls + k];
+        const T *rowK = x.matrix_ + k * xs;
+        for (int j = 0; j != m; ++j) rowI[j] -= factor * rowK[j];
+      }
+      const T scale = 1.0 / l[i * ls + i];
+      for (int j = 0; j != m; ++j) rowI[j] *= scale;
+    }
+    for (int i = n - 1; i >= 0; --i) {
+      T *rowI = x.matrix_ + i * xs;
+      const T scale = 1.0 / l[i * ls + i];
+      for (int j = 0; j != m; ++j) rowI[j] *= scale;
+      for (int k = 0; k != i; ++k) {
+        const T factor = l[i * ls + k];
+        T *rowK = x.matrix_ + k * xs;
+        for (int j = 0; j != m; ++j) rowK[j] -= factor * rowI[j];
+      }
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+    x.DeleteMatrix();
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Inverse() const {
+  S21ScratchScope scope;
+  S21BasicMatrix<T> identity = S21BasicMatrix<T>::Scratch(l_.rows_, l_.rows_);
+  for (int i = 0; i != l_.rows_; ++i) {
+    identity.matrix_[i * identity.stride_ + i] = 1.0;
+  }
+  return Solve(identity);
+}
+
+template <typename T>
+T S21BasicCholesky<T>::LogDeterminant() const {
+  if (!positive_) return std::numeric_limits<T>::quiet_NaN();
+  T sum = 0;
+  for (int i = 0; i != l_.rows_; ++i) {
+    sum += std::log(l_.matrix_[i * l_.stride_ + i]);
+  }
+  return 2 * sum;
+}
+
+// Whether a diagonal element left after the updates is a usable pivot
+template <typename T>
+static bool PositivePivot(T diagonal) {
+  return diagonal > 0 && std::sqrt(diagonal) > S21Tolerance<T>::kValue;
+}
+
+// Left-looking blocked factorization: a panel of columns first subtracts
+// L(first.., 0..first) * L(first..first + cols, 0..first)^T, computed by
+// the blocked matrix product, and is then factorized on its own.
+// remaining(i) tracks A(i, i) minus the squares of row i of the factorized
+// columns, at O(n) per column; a pivot only shrinks as columns are added,
+// so a matrix that is not positive definite is given up as soon as one of
+// them fails instead of when the factorization reaches its column
+template <typename T>
+void S21BasicCholesky<T>::Factorize() {
+  const int n = l_.rows_, ls = l_.stride_;
+  S21ScratchScope scope;
+  S21BasicMatrix<T> remaining = S21BasicMatrix<T>::Scratch(1, n);
+  T *d = remaining.matrix_;
+  for (int i = 0; i != n && positive_; ++i) {
+    d[i] = l_.matrix_[i * ls + i];
+    positive_ = PositivePivot(d[i]);
+  }
+  for (int first = 0; first < n && positive_; first += kCholeskyBlock) {
+    const int cols = std::min(kCholeskyBlock, n - first);
+    if (first != 0) {
+      S21ScratchScope scope;
+      S21BasicMatrix<T> update = S21BasicMatrix<T>::Scratch(n - first, cols);
+      S21BasicMatrix<T>::Gemm(1, l_.Block(first, 0, n - first, first), false,
+                              l_.Block(first, 0, cols, first), true, 0,
+                              update);
+      for (int i = first; i != n; ++i) {
+        const int last = std::min(cols, i - first + 1);
+        const T *src = update.matrix_ + (i - first) * update.stride_;
+        T *dst = l_.matrix_ + i * ls + first;
+        for (int j = 0; j != last; ++j) dst[j] -= src[j];
+      }
+    }
+    FactorizePanel(first, cols);
+    for (int i = first + cols; i != n && positive_; ++i) {
+      const T *row = l_.matrix_ + i * ls;
+      for (int p = first; p != first + cols; ++p) d[i] -= row[p] * row[p];
+      positive_ = PositivePivot(d[i]);
+    }
+  }
+  for (int i = 0; i != n; ++i) {
+    std::fill(l_.matrix_ + i * ls + i + 1, l_.matrix_ + (i + 1) * ls, 0.0);
+  }
+}
+
+// Unblocked Cholesky of columns [first, first + cols) on rows first.., the
+// dot products only run over the columns of the panel
+template <typename T>
+void S21BasicCholesky<T>::FactorizePanel(int first, int cols) {
+  const int n = l_.rows_, ls = l_.stride_;
+  T *a = l_.matrix_;
+  for (int j = first; j != first + cols; ++j) {
+    const T *rowJ = a + j * ls;
+    T diagonal = rowJ[j];
+    for (int p = first; p != j; ++p) diagonal -= rowJ[p] * rowJ[p];
+    if (!PositivePivot(diagonal)) {
+      positive_ = false;
+      return;
+    }
+    const T pivot = std::sqrt(diagonal);
+    a[j * ls + j] = pivot;
+    for (int i = j + 1; i != n; ++i) {
+      T *rowI = a + i * ls;
+      T sum = rowI[j];
+      for (int p = first; p != j; ++p) sum -= rowI[p] * rowJ[p];
+      rowI[j] = sum / pivot;
+    }
+  }
+}
+
+template class S21BasicCholesky<float>;
+template class S21BasicCholesky<double>;
+template class S21BasicCholesky<long double>;
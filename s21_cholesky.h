@@ -0,0 +1,41 @@
+#ifndef S21_CHOLESKY_H
+#define S21_CHOLESKY_H
+
+#include "s21_matrix_oop.h"
+
+// Cholesky factorization A = L * L^T of a symmetric positive definite
+// matrix. It needs no pivoting and half the work of S21BasicLU; only the
+// lower triangle of the matrix is read
+template <typename T>
+class S21BasicCholesky {
+ private:
+  // L on and below the diagonal, zeros above it
+  S21BasicMatrix<T> l_;
+  bool positive_;
+  void FactorizePanel(int first, int cols);
+  void Factorize();
+
+ public:
+  explicit S21BasicCholesky(const S21BasicMatrixView<T> &matrix);
+  // Factorizes the matrix in its own storage instead of a copy
+  explicit S21BasicCholesky(S21BasicMatrix<T> &&matrix);
+
+  int GetSize() const;
+  // False if a pivot was not positive, the matrix is then not positive
+  // definite and the factors are incomplete
+  bool IsPositiveDefinite() const;
+
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+  S21BasicMatrix<T> Inverse() const;
+  // Logarithm of the determinant, 2 * sum(log(L(i, i))). It does not
+  // overflow for large matrices, NaN if the matrix is not positive definite
+  T LogDeterminant() const;
+};
+
+using S21Cholesky = S21BasicCholesky<double>;
+
+extern template class S21BasicCholesky<float>;
+extern template class S21BasicCholesky<double>;
+extern template class S21BasicCholesky<long double>;
+
+#endif  // S21_CHOLESKY_H
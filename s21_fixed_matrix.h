@@ -0,0 +1,218 @@
+#ifndef S21_FIXED_MATRIX_H
+#define S21_FIXED_MATRIX_H
+
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+// Matrix with dimensions fixed at compile time. Elements live inside the
+// object, so it never allocates, sizes of operands are checked by the
+// compiler, and everything except the conversions can run in constexpr
+// context. Element access is unchecked
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "There should be at least 1 row and column.");
+
+  template <int, int>
+  friend class S21FixedMatrix;
+
+ private:
+  double matrix_[R * C];
+  static constexpr double Abs(double x) { return x < 0 ? -x : x; }
+  constexpr void SwapRows(int first, int second) {
+    for (int j = 0; j != C; ++j) {
+      const double tmp = matrix_[first * C + j];
+      matrix_[first * C + j] = matrix_[second * C + j];
+      matrix_[second * C + j] = tmp;
+    }
+  }
+
+ public:
+  // Constructors
+  constexpr S21FixedMatrix() : matrix_{} {}
+  constexpr explicit S21FixedMatrix(const double (&values)[R][C])
+      : matrix_{} {
+    for (int i = 0; i != R; ++i) {
+      for (int j = 0; j != C; ++j) matrix_[i * C + j] = values[i][j];
+    }
+  }
+  explicit S21FixedMatrix(const S21Matrix &other) : matrix_{} {
+    if (other.GetRows() != R || other.GetCols() != C) {
+      throw std::invalid_argument("The sizes of matrices must match.");
+    }
+    for (int i = 0; i != R; ++i) {
+      for (int j = 0; j != C; ++j) matrix_[i * C + j] = other.Coeff(i, j);
+    }
+  }
+  explicit operator S21Matrix() const {
+    S21Matrix result(R, C);
+    for (int i = 0; i != R; ++i) {
+      for (int j = 0; j != C; ++j) result(i, j) = matrix_[i * C + j];
+    }
+    return result;
+  }
+
+  // Getters
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+
+  // Operations
+  constexpr bool EqMatrix(const S21FixedMatrix &other) const {
+    bool status = true;
+    for (int i = 0; i != R * C; ++i) {
+      if (Abs(matrix_[i] - other.matrix_[i]) >= S21Tolerance<double>::kValue)
+        status = false;
+    }
+    return status;
+  }
+  constexpr void SumMatrix(const S21FixedMatrix &other) {
+    for (int i = 0; i != R * C; ++i) matrix_[i] += other.matrix_[i];
+  }
+  constexpr void SubMatrix(const S21FixedMatrix &other) {
+    for (int i = 0; i != R * C; ++i) matrix_[i] -= other.matrix_[i];
+  }
+  constexpr void MulNumber(const double num) {
+    for (int i = 0; i != R * C; ++i) matrix_[i] *= num;
+  }
+  constexpr S21FixedMatrix<C, R> Transpose() const {
+    S21FixedMatrix<C, R> transposed;
+    for (int i = 0; i != R; ++i) {
+      for (int j = 0; j != C; ++j) {
+        transposed.matrix_[j * R + i] = matrix_[i * C + j];
+      }
+    }
+    return transposed;
+  }
+  // Closed forms up to 3x3, Gaussian elimination with partial pivoting above
+  constexpr double Determinant() const {
+    static_assert(R == C, "Matrix must be square.");
+    const double *a = matrix_;
+    double det = a[0];
+    if constexpr (R == 2) {
+      det = a[0] * a[3] - a[2] * a[1];
+    } else if constexpr (R == 3) {
+      det = a[0] * (a[4] * a[8] - a[7] * a[5]) -
+            a[1] * (a[3] * a[8] - a[6] * a[5]) +
+            a[2] * (a[3] * a[7] - a[6] * a[4]);
+    } else if constexpr (R > 3) {
+      S21FixedMatrix lu(*this);
+      double *m = lu.matrix_;
+      det = 1.0;
+      for (int k = 0; k != R && det != 0.0; ++k) {
+        int pivot = k;
+        for (int i = k + 1; i != R; ++i) {
+          if (Abs(m[i * C + k]) > Abs(m[pivot * C + k])) pivot = i;
+        }
+        if (pivot != k) {
+          lu.SwapRows(k, pivot);
+          det = -det;
+        }
+        det *= m[k * C + k];
+        if (det != 0.0) {
+          for (int i = k + 1; i != R; ++i) {
+            const double factor = m[i * C + k] / m[k * C + k];
+            for (int j = k + 1; j != C; ++j) {
+              m[i * C + j] -= factor * m[k * C + j];
+            }
+          }
+        }
+      }
+    }
+    return det;
+  }
+  // Gauss-Jordan elimination, a fixed-size result cannot be left empty, so a
+  // singular matrix throws
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "Matrix must be square.");
+    S21FixedMatrix work(*this), inversed;
+    double *a = work.matrix_, *inv = inversed.matrix_;
+    for (int i = 0; i != R; ++i) inv[i * C + i] = 1.0;
+    for (int k = 0; k != R; ++k) {
+      int pivot = k;
+      for (int i = k + 1; i != R; ++i) {
+        if (Abs(a[i * C + k]) > Abs(a[pivot * C + k])) pivot = i;
+      }
+      if (Abs(a[pivot * C + k]) <= S21Tolerance<double>::kValue) {
+        throw std::invalid_argument(
+            "Cannot inverse a matrix with 0 determinant.");
+      }
+      if (pivot != k) {
+        work.SwapRows(k, pivot);
+        inversed.SwapRows(k, pivot);
+      }
+      const double scale = 1.0 / a[k * C + k];
+      for (int j = 0; j != C; ++j) {
+        a[k * C + j] *= scale;
+        inv[k * C + j] *= scale;
+      }
+      for (int i = 0; i != R; ++i) {
+        const double factor = a[i * C + k];
+        if (i != k) {
+          for (int j = 0; j != C; ++j) {
+            a[i * C + j] -= factor * a[k * C + j];
+            inv[i * C + j] -= factor * inv[k * C + j];
+          }
+        }
+      }
+    }
+    return inversed;
+  }
+
+  // Operators
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    result.SumMatrix(other);
+    return result;
+  }
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    result.SubMatrix(other);
+    return result;
+  }
+  constexpr S21FixedMatrix operator*(const double num) const {
+    S21FixedMatrix result(*this);
+    result.MulNumber(num);
+    return result;
+  }
+  template <int K>
+  constexpr S21FixedMatrix<R, K> operator*(
+      const S21FixedMatrix<C, K> &other) const {
+    S21FixedMatrix<R, K> result;
+    for (int i = 0; i != R; ++i) {
+      for (int k = 0; k != C; ++k) {
+        const double a = matrix_[i * C + k];
+        for (int j = 0; j != K; ++j) {
+          result.matrix_[i * K + j] += a * other.matrix_[k * K + j];
+        }
+      }
+    }
+    return result;
+  }
+  constexpr bool operator==(const S21FixedMatrix &other) const {
+    return EqMatrix(other);
+  }
+  constexpr S21FixedMatrix &operator+=(const S21FixedMatrix &other) {
+    SumMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator-=(const S21FixedMatrix &other) {
+    SubMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator*=(const S21FixedMatrix<C, C> &other) {
+    *this = *this * other;
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator*=(const double num) {
+    MulNumber(num);
+    return *this;
+  }
+  constexpr double &operator()(int row, int col) {
+    return matrix_[row * C + col];
+  }
+  constexpr const double &operator()(int row, int col) const {
+    return matrix_[row * C + col];
+  }
+};
+
+#endif  // S21_FIXED_MATRIX_H
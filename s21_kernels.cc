@@ -0,0 +1,245 @@
+#include "s21_kernels.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define S21_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+using Scalar = S21ScalarKernels<double>;
+
+static const S21Kernels kScalar = {"scalar",    Scalar::Gemm,  Scalar::Add,
+                                   Scalar::Sub, Scalar::Scale, Scalar::Axpy};
+
+#ifdef S21_X86_KERNELS
+
+// 4x8 register block: eight ymm accumulators hold a 4-row, 8-column tile of
+// C for the whole k loop, one broadcast of A feeds two FMAs
+__attribute__((target("avx2,fma"))) static void GemmAvx2(
+    int m, int n, int k, const double *a, int lda, const double *b, int ldb,
+    double *c, int ldc) {
+  int i = 0;
+  for (; i + 4 <= m; i += 4) {
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+      double *c0 = c + i * ldc + j, *c1 = c0 + ldc, *c2 = c1 + ldc,
+             *c3 = c2 + ldc;
+      __m256d c00 = _mm256_loadu_pd(c0), c01 = _mm256_loadu_pd(c0 + 4);
+      __m256d c10 = _mm256_loadu_pd(c1), c11 = _mm256_loadu_pd(c1 + 4);
+      __m256d c20 = _mm256_loadu_pd(c2), c21 = _mm256_loadu_pd(c2 + 4);
+      __m256d c30 = _mm256_loadu_pd(c3), c31 = _mm256_loadu_pd(c3 + 4);
+      const double *a0 = a + i * lda;
+      for (int p = 0; p != k; ++p) {
+        const __m256d b0 = _mm256_loadu_pd(b + p * ldb + j);
+        const __m256d b1 = _mm256_loadu_pd(b + p * ldb + j + 4);
+        __m256d alpha = _mm256_broadcast_sd(a0 + p);
+        c00 = _mm256_fmadd_pd(alpha, b0, c00);
+        c01 = _mm256_fmadd_pd(alpha, b1, c01);
+        alpha = _mm256_broadcast_sd(a0 + lda + p);
+        c10 = _mm256_fmadd_pd(alpha, b0, c10);
+        c11 = _mm256_fmadd_pd(alpha, b1, c11);
+        alpha = _mm256_broadcast_sd(a0 + 2 * lda + p);
+        c20 = _mm256_fmadd_pd(alpha, b0, c20);
+        c21 = _mm256_fmadd_pd(alpha, b1, c21);
+        alpha = _mm256_broadcast_sd(a0 + 3 * lda + p);
+        c30 = _mm256_fmadd_pd(alpha, b0, c30);
+        c31 = _mm256_fmadd_pd(alpha, b1, c31);
+      }
+      _mm256_storeu_pd(c0, c00);
+      _mm256_storeu_pd(c0 + 4, c01);
+      _mm256_storeu_pd(c1, c10);
+      _mm256_storeu_pd(c1 + 4, c11);
+      _mm256_storeu_pd(c2, c20);
+      _mm256_storeu_pd(c2 + 4, c21);
+      _mm256_storeu_pd(c3, c30);
+      _mm256_storeu_pd(c3 + 4, c31);
+    }
+    if (j != n) {
+      Scalar::Gemm(4, n - j, k, a + i * lda, lda, b + j, ldb, c + i * ldc + j,
+                   ldc);
+    }
+  }
+  if (i != m) {
+    Scalar::Gemm(m - i, n, k, a + i * lda, lda, b, ldb, c + i * ldc, ldc);
+  }
+}
+
+__attribute__((target("avx2"))) static void AddAvx2(int n, const double *x,
+                                                    double *y) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d value = _mm256_loadu_pd(y + i);
+    value = _mm256_add_pd(value, _mm256_loadu_pd(x + i));
+    _mm256_storeu_pd(y + i, value);
+  }
+  Scalar::Add(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx2"))) static void SubAvx2(int n, const double *x,
+                                                    double *y) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d value = _mm256_loadu_pd(y + i);
+    value = _mm256_sub_pd(value, _mm256_loadu_pd(x + i));
+    _mm256_storeu_pd(y + i, value);
+  }
+  Scalar::Sub(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx2"))) static void ScaleAvx2(int n, double alpha,
+                                                      double *y) {
+  const __m256d factor = _mm256_set1_pd(alpha);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_loadu_pd(y + i), factor));
+  }
+  Scalar::Scale(n - i, alpha, y + i);
+}
+
+__attribute__((target("avx2,fma"))) static void AxpyAvx2(int n, double alpha,
+                                                         const double *x,
+                                                         double *y) {
+  const __m256d factor = _mm256_set1_pd(alpha);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(y + i, _mm256_fmadd_pd(factor, _mm256_loadu_pd(x + i),
+                                            _mm256_loadu_pd(y + i)));
+  }
+  Scalar::Axpy(n - i, alpha, x + i, y + i);
+}
+
+// 4x16 register block, the AVX-512 counterpart of GemmAvx2
+__attribute__((target("avx512f"))) static void GemmAvx512(
+    int m, int n, int k, const double *a, int lda, const double *b, int ldb,
+    double *c, int ldc) {
+  int i = 0;
+  for (; i + 4 <= m; i += 4) {
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+      double *c0 = c + i * ldc + j, *c1 = c0 + ldc, *c2 = c1 + ldc,
+             *c3 = c2 + ldc;
+      __m512d c00 = _mm512_loadu_pd(c0), c01 = _mm512_loadu_pd(c0 + 8);
+      __m512d c10 = _mm512_loadu_pd(c1), c11 = _mm512_loadu_pd(c1 + 8);
+      __m512d c20 = _mm512_loadu_pd(c2), c21 = _mm512_loadu_pd(c2 + 8);
+      __m512d c30 = _mm512_loadu_pd(c3), c31 = _mm512_loadu_pd(c3 + 8);
+      const double *a0 = a + i * lda;
+      for (int p = 0; p != k; ++p) {
+        const __m512d b0 = _mm512_loadu_pd(b + p * ldb + j);
+        const __m512d b1 = _mm512_loadu_pd(b + p * ldb + j + 8);
+        __m512d alpha = _mm512_set1_pd(a0[p]);
+        c00 = _mm512_fmadd_pd(alpha, b0, c00);
+        c01 = _mm512_fmadd_pd(alpha, b1, c01);
+        alpha = _mm512_set1_pd(a0[lda + p]);
+        c10 = _mm512_fmadd_pd(alpha, b0, c10);
+        c11 = _mm512_fmadd_pd(alpha, b1, c11);
+        alpha = _mm512_set1_pd(a0[2 * lda + p]);
+        c20 = _mm512_fmadd_pd(alpha, b0, c20);
+        c21 = _mm512_fmadd_pd(alpha, b1, c21);
+        alpha = _mm512_set1_pd(a0[3 * lda + p]);
+        c30 = _mm512_fmadd_pd(alpha, b0, c30);
+        c31 = _mm512_fmadd_pd(alpha, b1, c31);
+      }
+      _mm512_storeu_pd(c0, c00);
+      _mm512_storeu_pd(c0 + 8, c01);
+      _mm512_storeu_pd(c1, c10);
+      _mm512_storeu_pd(c1 + 8, c11);
+      _mm512_storeu_pd(c2, c20);
+      _mm512_storeu_pd(c2 + 8, c21);
+      _mm512_storeu_pd(c3, c30);
+      _mm512_storeu_pd(c3 + 8, c31);
+    }
+    if (j != n) {
+      GemmAvx2(4, n - j, k, a + i * lda, lda, b + j, ldb, c + i * ldc + j,
+               ldc);
+    }
+  }
+  if (i != m) {
+    GemmAvx2(m - i, n, k, a + i * lda, lda, b, ldb, c + i * ldc, ldc);
+  }
+}
+
+__attribute__((target("avx512f"))) static void AddAvx512(int n,
+                                                         const double *x,
+                                                         double *y) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d value = _mm512_loadu_pd(y + i);
+    value = _mm512_add_pd(value, _mm512_loadu_pd(x + i));
+    _mm512_storeu_pd(y + i, value);
+  }
+  AddAvx2(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx512f"))) static void SubAvx512(int n,
+                                                         const double *x,
+                                                         double *y) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d value = _mm512_loadu_pd(y + i);
+    value = _mm512_sub_pd(value, _mm512_loadu_pd(x + i));
+    _mm512_storeu_pd(y + i, value);
+  }
+  SubAvx2(n - i, x + i, y + i);
+}
+
+__attribute__((target("avx512f"))) static void ScaleAvx512(int n, double alpha,
+                                                           double *y) {
+  const __m512d factor = _mm512_set1_pd(alpha);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(y + i, _mm512_mul_pd(_mm512_loadu_pd(y + i), factor));
+  }
+  ScaleAvx2(n - i, alpha, y + i);
+}
+
+__attribute__((target("avx512f"))) static void AxpyAvx512(int n, double alpha,
+                                                          const double *x,
+                                                          double *y) {
+  const __m512d factor = _mm512_set1_pd(alpha);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(y + i, _mm512_fmadd_pd(factor, _mm512_loadu_pd(x + i),
+                                            _mm512_loadu_pd(y + i)));
+  }
+  AxpyAvx2(n - i, alpha, x + i, y + i);
+}
+
+static const S21Kernels kAvx2 = {"avx2",  GemmAvx2,  AddAvx2,
+                                 SubAvx2, ScaleAvx2, AxpyAvx2};
+static const S21Kernels kAvx512 = {"avx512",  GemmAvx512,  AddAvx512,
+                                   SubAvx512, ScaleAvx512, AxpyAvx512};
+
+#endif  // S21_X86_KERNELS
+
+const S21Kernels *S21FindKernels(const char *name) {
+  const S21Kernels *found = nullptr;
+  if (std::strcmp(name, "scalar") == 0) found = &kScalar;
+#ifdef S21_X86_KERNELS
+  __builtin_cpu_init();
+  const bool avx2 =
+      __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  // The AVX-512 set falls back to AVX2 code for its tails
+  if (std::strcmp(name, "avx2") == 0 && avx2) found = &kAvx2;
+  if (std::strcmp(name, "avx512") == 0 && avx2 &&
+      __builtin_cpu_supports("avx512f"))
+    found = &kAvx512;
+#endif
+  return found;
+}
+
+static const S21Kernels &SelectKernels() {
+  const S21Kernels *kernels = nullptr;
+  const char *forced = std::getenv("S21_MATRIX_KERNELS");
+  if (forced) kernels = S21FindKernels(forced);
+  if (!kernels) kernels = S21FindKernels("avx512");
+  if (!kernels) kernels = S21FindKernels("avx2");
+  if (!kernels) kernels = &kScalar;
+  return *kernels;
+}
+
+const S21Kernels &S21ActiveKernels() {
+  static const S21Kernels &kernels = SelectKernels();
+  return kernels;
+}
@@ -0,0 +1,83 @@
+#ifndef S21_KERNELS_H
+#define S21_KERNELS_H
+
+// Low-level loops behind S21Matrix. Every entry point has a scalar version
+// and, on x86-64, AVX2/FMA and AVX-512 versions; the fastest one the host
+// supports is picked once at startup
+struct S21Kernels {
+  const char *name;
+  // C[m x n] += A[m x k] * B[k x n], all row-major with the given strides
+  void (*gemm)(int m, int n, int k, const double *a, int lda, const double *b,
+               int ldb, double *c, int ldc);
+  // y += x
+  void (*add)(int n, const double *x, double *y);
+  // y -= x
+  void (*sub)(int n, const double *x, double *y);
+  // y *= alpha
+  void (*scale)(int n, double alpha, double *y);
+  // y += alpha * x
+  void (*axpy)(int n, double alpha, const double *x, double *y);
+};
+
+// Portable loops behind the scalar kernel set, also used directly by float
+// and long double matrices, which have no SIMD kernels
+template <typename T>
+struct S21ScalarKernels {
+  static void Gemm(int m, int n, int k, const T *a, int lda, const T *b,
+                   int ldb, T *c, int ldc) {
+    for (int i = 0; i != m; ++i) {
+      T *dst = c + i * ldc;
+      for (int p = 0; p != k; ++p) {
+        const T alpha = a[i * lda + p];
+        const T *rhs = b + p * ldb;
+        for (int j = 0; j != n; ++j) dst[j] += alpha * rhs[j];
+      }
+    }
+  }
+  static void Add(int n, const T *x, T *y) {
+    for (int i = 0; i != n; ++i) y[i] += x[i];
+  }
+  static void Sub(int n, const T *x, T *y) {
+    for (int i = 0; i != n; ++i) y[i] -= x[i];
+  }
+  static void Scale(int n, T alpha, T *y) {
+    for (int i = 0; i != n; ++i) y[i] *= alpha;
+  }
+  static void Axpy(int n, T alpha, const T *x, T *y) {
+    for (int i = 0; i != n; ++i) y[i] += alpha * x[i];
+  }
+};
+
+// Kernels used by the library. S21_MATRIX_KERNELS=scalar|avx2|avx512 in the
+// environment overrides the choice if the host supports the requested set
+const S21Kernels &S21ActiveKernels();
+
+// Kernel set by name, nullptr if it is unknown or the host cannot run it
+const S21Kernels *S21FindKernels(const char *name);
+
+// Kernels for element type T: double runs on the active SIMD set, float and
+// long double on the portable loops
+template <typename T>
+struct S21TypedKernels : S21ScalarKernels<T> {};
+
+template <>
+struct S21TypedKernels<double> {
+  static void Gemm(int m, int n, int k, const double *a, int lda,
+                   const double *b, int ldb, double *c, int ldc) {
+    S21ActiveKernels().gemm(m, n, k, a, lda, b, ldb, c, ldc);
+  }
+  static void Add(int n, const double *x, double *y) {
+    S21ActiveKernels().add(n, x, y);
+  }
+  static void Sub(int n, const double *x, double *y) {
+    S21ActiveKernels().sub(n, x, y);
+  }
+  static void Scale(int n, double alpha, double *y) {
+    S21ActiveKernels().scale(n, alpha, y);
+  }
+  static void Axpy(int n, double alpha, const double *x, double *y) {
+    S21ActiveKernels().axpy(n, alpha, x, y);
+  }
+};
+
+#endif  // S21_KERNELS_H
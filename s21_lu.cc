@@ -0,0 +1,136 @@
+#include "s21_lu.h"
+
+#include "s21_scratch_arena.h"
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrixView<T> &matrix)
+    : lu_(matrix), perm_(matrix.GetRows()), sign_(1), singular_(false) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::invalid_argument("Matrix must be square.");
+  }
+  Factorize();
+}
+
+template <typename T>
+int S21BasicLU<T>::GetSize() const { return lu_.rows_; }
+
+template <typename T>
+bool S21BasicLU<T>::IsSingular() const { return singular_; }
+
+// Solves A * X = B for every column of B with two triangular sweeps, O(n^2)
+// per right-hand side
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(const S21BasicMatrix<T> &b) const {
+  const int n = lu_.rows_, m = b.cols_, ls = lu_.stride_;
+  S21BasicMatrix<T> x = S21BasicMatrix<T>();
+  try {
+    if (b.rows_ != n)
+      throw std::invalid_argument("Wrong matrices sizes for solving.");
+    if (singular_)
+      throw std::invalid_argument("Cannot solve a system with 0 determinant.");
+    x = S21BasicMatrix<T>(n, m);
+    const int xs = x.stride_;
+    const T *lu = lu_.matrix_;
+    for (int i = 0; i != n; ++i) {
+      std::copy(b.matrix_ + perm_[i] * b.stride_,
+                b.matrix_ + perm_[i] * b.stride_ + m, x.matrix_ + i * xs);
+    }
+    // Forward substitution with the unit lower triangle
+    for (int i = 1; i != n; ++i) {
+      T *rowI = x.matrix_ + i * xs;
+      for (int k = 0; k != i; ++k) {
+        const T l = lu[i * ls + k];
+        const T *rowK = x.matrix_ + k * xs;
+        for (int j = 0; j != m; ++j) rowI[j] -= l * rowK[j];
+      }
+    }
+    // Back substitution with the upper triangle
+    for (int i = n - 1; i >= 0; --i) {
+      T *rowI = x.matrix_ + i * xs;
+      for (int k = i + 1; k != n; ++k) {
+        const T u = lu[i * ls + k];
+        const T *rowK = x.matrix_ + k * xs;
+        for (int j = 0; j != m; ++j) rowI[j] -= u * rowK[j];
+      }
+      const T scale = 1.0 / lu[i * ls + i];
+      for (int j = 0; j != m; ++j) rowI[j] *= scale;
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+    x.DeleteMatrix();
+  }
+  return x;
+}
+
+template <typename T>
+T S21BasicLU<T>::Determinant() const {
+  T det = sign_;
+  for (int i = 0; i != lu_.rows_; ++i) det *= lu_.matrix_[i * lu_.stride_ + i];
+  return det;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() const {
+  S21ScratchScope scope;
+  S21BasicMatrix<T> identity = S21BasicMatrix<T>::Scratch(lu_.rows_, lu_.rows_);
+  for (int i = 0; i != lu_.rows_; ++i) {
+    identity.matrix_[i * identity.stride_ + i] = 1.0;
+  }
+  return Solve(identity);
+}
+
+// Doolittle elimination in place of the n x n matrix a, a column without a
+// nonzero pivot is left as is so that U gets a zero on its diagonal. The row
+// swaps are recorded in perm unless it is nullptr, the sign of the
+// permutation in sign. Returns false if a pivot is 0 within the tolerance
+template <typename T>
+static bool Eliminate(T *a, int n, int stride, int *perm, int &sign) {
+  bool regular = true;
+  for (int k = 0; k != n; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i != n; ++i) {
+      if (std::abs(a[i * stride + k]) > std::abs(a[pivot * stride + k]))
+        pivot = i;
+    }
+    if (std::abs(a[pivot * stride + k]) <= S21Tolerance<T>::kValue)
+      regular = false;
+    if (a[pivot * stride + k] != 0.0) {
+      if (pivot != k) {
+        std::swap_ranges(a + k * stride, a + k * stride + n,
+                         a + pivot * stride);
+        if (perm) std::swap(perm[k], perm[pivot]);
+        sign = -sign;
+      }
+      const T *rowK = a + k * stride;
+      for (int i = k + 1; i != n; ++i) {
+        T *rowI = a + i * stride;
+        const T factor = rowI[k] / rowK[k];
+        rowI[k] = factor;
+        for (int j = k + 1; j != n; ++j) rowI[j] -= factor * rowK[j];
+      }
+    }
+  }
+  return regular;
+}
+
+template <typename T>
+void S21BasicLU<T>::Factorize() {
+  for (int i = 0; i != lu_.rows_; ++i) perm_[i] = i;
+  singular_ = !Eliminate(lu_.matrix_, lu_.rows_, lu_.stride_, perm_.data(),
+                         sign_);
+}
+
+template <typename T>
+T S21BasicLU<T>::FactorizeDeterminant(S21BasicMatrix<T> &matrix) {
+  int sign = 1;
+  Eliminate(matrix.matrix_, matrix.rows_, matrix.stride_, nullptr, sign);
+  T det = sign;
+  for (int i = 0; i != matrix.rows_; ++i) {
+    det *= matrix.matrix_[i * matrix.stride_ + i];
+  }
+  return det;
+}
+
+template class S21BasicLU<float>;
+template class S21BasicLU<double>;
+template class S21BasicLU<long double>;
@@ -0,0 +1,42 @@
+#ifndef S21_LU_H
+#define S21_LU_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU factorization with partial pivoting, P * A = L * U. The factors are
+// computed once and reused by every Solve(), Determinant() and Inverse()
+template <typename T>
+class S21BasicLU {
+ private:
+  // Unit lower triangle L below the diagonal, U on and above it
+  S21BasicMatrix<T> lu_;
+  // Row i of the factorization is row perm_[i] of the original matrix
+  std::vector<int> perm_;
+  int sign_;
+  bool singular_;
+  void Factorize();
+
+ public:
+  explicit S21BasicLU(const S21BasicMatrixView<T> &matrix);
+
+  int GetSize() const;
+  bool IsSingular() const;
+
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &b) const;
+  T Determinant() const;
+  S21BasicMatrix<T> Inverse() const;
+
+  // Determinant of a square matrix that is overwritten by its factors,
+  // nothing else is kept or allocated
+  static T FactorizeDeterminant(S21BasicMatrix<T> &matrix);
+};
+
+using S21LU = S21BasicLU<double>;
+
+extern template class S21BasicLU<float>;
+extern template class S21BasicLU<double>;
+extern template class S21BasicLU<long double>;
+
+#endif  // S21_LU_H
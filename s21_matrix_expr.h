@@ -0,0 +1,188 @@
+#ifndef S21_MATRIX_EXPR_H
+#define S21_MATRIX_EXPR_H
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+template <typename T>
+class S21BasicMatrix;
+
+// Tolerance of EqMatrix and of the singularity checks: 1e-7 for double and
+// scaled to the precision of the other element types
+template <typename T>
+struct S21Tolerance;
+
+template <>
+struct S21Tolerance<float> {
+  static constexpr float kValue = 1.0e-4f;
+};
+
+template <>
+struct S21Tolerance<double> {
+  static constexpr double kValue = 1.0e-7;
+};
+
+template <>
+struct S21Tolerance<long double> {
+  static constexpr long double kValue = 1.0e-10L;
+};
+
+// Base of everything that may stand on either side of +, - and scalar *:
+// S21Matrix itself and the lazy nodes below. A node only describes how to
+// compute element (i, j); the whole expression is evaluated in one pass when
+// it is assigned to a matrix, without intermediate matrices. Every node has
+// the value_type of its matrices, mixing element types does not compile, and
+// tells through ReadsTransposed() whether it reads a transposed view of a
+// range, which the assignment has to evaluate into a new matrix first
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E &Derived() const { return static_cast<const E &>(*this); }
+};
+
+// Matrices are held by reference and nested nodes by value, so an expression
+// stays valid as long as the matrices it was built from
+template <typename E>
+struct S21ExprOperand {
+  using type = const E;
+};
+
+template <typename T>
+struct S21ExprOperand<S21BasicMatrix<T>> {
+  using type = const S21BasicMatrix<T> &;
+};
+
+struct S21SumOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a + b;
+  }
+};
+
+struct S21SubOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a - b;
+  }
+};
+
+template <typename L, typename R, typename Op>
+class S21BinaryExpr : public S21MatrixExpr<S21BinaryExpr<L, R, Op>> {
+ private:
+  typename S21ExprOperand<L>::type lhs_;
+  typename S21ExprOperand<R>::type rhs_;
+  // As in SumMatrix and SubMatrix, operands of different sizes leave the
+  // left one unchanged
+  bool mismatch_;
+
+ public:
+  using value_type = typename L::value_type;
+  static_assert(std::is_same<value_type, typename R::value_type>::value,
+                "Operands must have the same element type.");
+
+  S21BinaryExpr(const L &lhs, const R &rhs)
+      : lhs_(lhs),
+        rhs_(rhs),
+        mismatch_(lhs.GetRows() != rhs.GetRows() ||
+                  lhs.GetCols() != rhs.GetCols()) {
+    if (mismatch_) {
+      std::cout << "The sizes of matrices must match." << std::endl;
+    }
+  }
+  int GetRows() const { return lhs_.GetRows(); }
+  int GetCols() const { return lhs_.GetCols(); }
+  value_type Coeff(int row, int col) const {
+    return mismatch_ ? lhs_.Coeff(row, col)
+                     : Op::Apply(lhs_.Coeff(row, col), rhs_.Coeff(row, col));
+  }
+  bool ReadsTransposed(const value_type *begin, const value_type *end) const {
+    return lhs_.ReadsTransposed(begin, end) || rhs_.ReadsTransposed(begin, end);
+  }
+};
+
+template <typename E>
+class S21ScaledExpr : public S21MatrixExpr<S21ScaledExpr<E>> {
+ private:
+  typename S21ExprOperand<E>::type operand_;
+  typename E::value_type num_;
+
+ public:
+  using value_type = typename E::value_type;
+
+  S21ScaledExpr(const E &operand, value_type num)
+      : operand_(operand), num_(num) {}
+  int GetRows() const { return operand_.GetRows(); }
+  int GetCols() const { return operand_.GetCols(); }
+  value_type Coeff(int row, int col) const {
+    return operand_.Coeff(row, col) * num_;
+  }
+  bool ReadsTransposed(const value_type *begin, const value_type *end) const {
+    return operand_.ReadsTransposed(begin, end);
+  }
+};
+
+template <typename L, typename R>
+S21BinaryExpr<L, R, S21SumOp> operator+(const S21MatrixExpr<L> &lhs,
+                                        const S21MatrixExpr<R> &rhs) {
+  return S21BinaryExpr<L, R, S21SumOp>(lhs.Derived(), rhs.Derived());
+}
+
+template <typename L, typename R>
+S21BinaryExpr<L, R, S21SubOp> operator-(const S21MatrixExpr<L> &lhs,
+                                        const S21MatrixExpr<R> &rhs) {
+  return S21BinaryExpr<L, R, S21SubOp>(lhs.Derived(), rhs.Derived());
+}
+
+template <typename E>
+S21ScaledExpr<E> operator*(const S21MatrixExpr<E> &expr,
+                           typename E::value_type num) {
+  return S21ScaledExpr<E>(expr.Derived(), num);
+}
+
+template <typename E>
+S21ScaledExpr<E> operator*(typename E::value_type num,
+                           const S21MatrixExpr<E> &expr) {
+  return S21ScaledExpr<E>(expr.Derived(), num);
+}
+
+// Element-wise loops over expressions visit kExprTile x kExprTile tiles in
+// turn, so that the strided reads of a transposed view stay in cache
+static constexpr int kExprTile = 32;
+
+// Calls body(i, j) for every element of a rows x cols matrix tile by tile,
+// stops as soon as it returns false
+template <typename F>
+bool S21ForEachTiled(int rows, int cols, F body) {
+  for (int ii = 0; ii < rows; ii += kExprTile) {
+    const int rowEnd = std::min(ii + kExprTile, rows);
+    for (int jj = 0; jj < cols; jj += kExprTile) {
+      const int colEnd = std::min(jj + kExprTile, cols);
+      for (int i = ii; i != rowEnd; ++i) {
+        for (int j = jj; j != colEnd; ++j) {
+          if (!body(i, j)) return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Element-wise comparison of two expressions with the tolerance of their
+// element type, operands of different sizes are never equal
+template <typename L, typename R>
+bool S21ExprEqual(const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs) {
+  using T = typename L::value_type;
+  static_assert(std::is_same<T, typename R::value_type>::value,
+                "Operands must have the same element type.");
+  const L &a = lhs.Derived();
+  const R &b = rhs.Derived();
+  return a.GetRows() == b.GetRows() && a.GetCols() == b.GetCols() &&
+         S21ForEachTiled(a.GetRows(), a.GetCols(), [&](int i, int j) {
+           return std::abs(a.Coeff(i, j) - b.Coeff(i, j)) <
+                  S21Tolerance<T>::kValue;
+         });
+}
+
+#endif  // S21_MATRIX_EXPR_H
@@ -1,10 +1,317 @@
 #include "s21_matrix_oop.h"
 
+#include <atomic>
+#include <new>
+
+#include "s21_buffer_pool.h"
+#include "s21_cholesky.h"
+#include "s21_kernels.h"
+#include "s21_lu.h"
+#include "s21_scratch_arena.h"
+#include "s21_thread_pool.h"
+
+// Largest size handled by the closed-form determinant and adjugate below
+static const int kClosedFormMaxSize = 4;
+// Smallest rows * inner * cols product for which MulMatrix uses tiles
+static const long kTiledMinVolume = 48L * 48 * 48;
+// Smallest rows * inner * cols product worth splitting between threads
+static const long kParallelMinVolume = 128L * 128 * 128;
+// Tile sizes of the blocked product: a kTileInner x kTileCols panel of the
+// right operand is packed to stay in L2, kTileRows rows of the left operand
+// stream against it
+static const int kTileRows = 64, kTileInner = 256, kTileCols = 256;
+// The recursive transposes below stop splitting at blocks of this size
+static const int kTransposeLeaf = 16;
+
+// Row-major operand of a product, read transposed when trans is set
+template <typename T>
+struct GemmOperand {
+  const T *data;
+  int stride;
+  bool trans;
+  T At(int row, int col) const {
+    return trans ? data[col * stride + row] : data[row * stride + col];
+  }
+};
+
+// C[m x n] += alpha * A[m x k] * B[k x n] with the plain triple loop
+template <typename T>
+static void GemmNaive(int m, int n, int k, T alpha, GemmOperand<T> a,
+                      GemmOperand<T> b, T *c, int ldc) {
+  for (int i = 0; i != m; ++i) {
+    T *dst = c + i * ldc;
+    for (int j = 0; j != n; ++j) {
+      for (int p = 0; p != k; ++p) {
+        dst[j] += alpha * a.At(i, p) * b.At(p, j);
+      }
+    }
+  }
+}
+
+// Blocked product of rows [rowBegin, rowEnd) and columns [colBegin, colEnd)
+// of C: a panel of op(B) scaled by alpha is packed into contiguous rows, and
+// so is a block of op(A) when A is transposed, then the SIMD kernel updates
+// every tile of C without striding down columns
+template <typename T>
+static void GemmTiled(int rowBegin, int rowEnd, int colBegin, int colEnd,
+                      int k, T alpha, GemmOperand<T> a, GemmOperand<T> b, T *c,
+                      int ldc) {
+  S21ScratchScope scope;
+  S21ScratchArena &arena = S21ScratchArena::Local();
+  T *panel = arena.Allocate<T>(kTileInner * kTileCols);
+  T *block = a.trans ? arena.Allocate<T>(kTileRows * kTileInner) : nullptr;
+  for (int jj = colBegin; jj < colEnd; jj += kTileCols) {
+    const int nc = std::min(kTileCols, colEnd - jj);
+    for (int kk = 0; kk < k; kk += kTileInner) {
+      const int kc = std::min(kTileInner, k - kk);
+      for (int p = 0; p != kc; ++p) {
+        T *dst = panel + p * nc;
+        if (b.trans) {
+          for (int j = 0; j != nc; ++j) dst[j] = b.At(kk + p, jj + j);
+        } else {
+          const T *src = b.data + (kk + p) * b.stride + jj;
+          std::copy(src, src + nc, dst);
+        }
+        if (alpha != 1) S21TypedKernels<T>::Scale(nc, alpha, dst);
+      }
+      for (int ii = rowBegin; ii < rowEnd; ii += kTileRows) {
+        const int mc = std::min(kTileRows, rowEnd - ii);
+        const T *lhs = a.data + ii * a.stride + kk;
+        int lda = a.stride;
+        if (a.trans) {
+          for (int i = 0; i != mc; ++i) {
+            for (int p = 0; p != kc; ++p) {
+              block[i * kc + p] = a.At(ii + i, kk + p);
+            }
+          }
+          lhs = block;
+          lda = kc;
+        }
+        S21TypedKernels<T>::Gemm(mc, nc, kc, lhs, lda, panel, nc,
+                                 c + ii * ldc + jj, ldc);
+      }
+    }
+  }
+}
+
+// Splits C into kTileRows x kTileCols tiles and hands them out to the
+// thread pool, each tile is an independent blocked product
+template <typename T>
+static void GemmParallel(int m, int n, int k, T alpha, GemmOperand<T> a,
+                         GemmOperand<T> b, T *c, int ldc, int threads) {
+  const int rowBlocks = (m + kTileRows - 1) / kTileRows;
+  const int colPanels = (n + kTileCols - 1) / kTileCols;
+  S21ThreadPool::Instance().ParallelFor(
+      rowBlocks * colPanels, 1,
+      [&](int begin, int end) {
+        for (int tile = begin; tile != end; ++tile) {
+          const int row = tile % rowBlocks * kTileRows;
+          const int col = tile / rowBlocks * kTileCols;
+          GemmTiled(row, std::min(row + kTileRows, m), col,
+                    std::min(col + kTileCols, n), k, alpha, a, b, c, ldc);
+        }
+      },
+      threads);
+}
+
+// C += alpha * op(A) * op(B) with the strategy that suits the size
+template <typename T>
+static void GemmUpdate(int m, int n, int k, T alpha, GemmOperand<T> a,
+                       GemmOperand<T> b, T *c, int ldc, int threads) {
+  const long volume = static_cast<long>(m) * n * k;
+  if (volume < kTiledMinVolume)
+    GemmNaive(m, n, k, alpha, a, b, c, ldc);
+  else if (volume < kParallelMinVolume || threads == 1)
+    GemmTiled(0, m, 0, n, k, alpha, a, b, c, ldc);
+  else
+    GemmParallel(m, n, k, alpha, a, b, c, ldc, threads);
+}
+
+// Whether the n x n block read with row stride s equals its transpose
+// element for element. Cholesky only reads the lower triangle, so a matrix
+// that is symmetric within the tolerance must not take its path
+template <typename T>
+static bool ExactlySymmetric(int n, const T *a, int s) {
+  for (int i = 1; i < n; ++i) {
+    for (int j = 0; j != i; ++j) {
+      if (a[i * s + j] != a[j * s + i]) return false;
+    }
+  }
+  return true;
+}
+
+// Closed-form determinant of an n x n block, n <= kClosedFormMaxSize, read
+// with row stride s. The 4x4 case expands along pairs of rows: s* are the
+// 2x2 minors of rows 0-1, c* the complementary minors of rows 2-3
+template <typename T>
+static T SmallDeterminant(int n, const T *a, int s) {
+  const T *r0 = a, *r1 = a + s, *r2 = a + 2 * s, *r3 = a + 3 * s;
+  T det = r0[0];
+  if (n == 2) {
+    det = r0[0] * r1[1] - r1[0] * r0[1];
+  } else if (n == 3) {
+    det = r0[0] * (r1[1] * r2[2] - r2[1] * r1[2]) -
+          r0[1] * (r1[0] * r2[2] - r2[0] * r1[2]) +
+          r0[2] * (r1[0] * r2[1] - r2[0] * r1[1]);
+  } else if (n == 4) {
+    det = (r0[0] * r1[1] - r1[0] * r0[1]) * (r2[2] * r3[3] - r3[2] * r2[3]) -
+          (r0[0] * r1[2] - r1[0] * r0[2]) * (r2[1] * r3[3] - r3[1] * r2[3]) +
+          (r0[0] * r1[3] - r1[0] * r0[3]) * (r2[1] * r3[2] - r3[1] * r2[2]) +
+          (r0[1] * r1[2] - r1[1] * r0[2]) * (r2[0] * r3[3] - r3[0] * r2[3]) -
+          (r0[1] * r1[3] - r1[1] * r0[3]) * (r2[0] * r3[2] - r3[0] * r2[2]) +
+          (r0[2] * r1[3] - r1[2] * r0[3]) * (r2[0] * r3[1] - r3[0] * r2[1]);
+  }
+  return det;
+}
+
+// Closed-form matrix of algebraic complements of an n x n block, 2 <= n <=
+// kClosedFormMaxSize, written to out with row stride os
+template <typename T>
+static void SmallComplements(int n, const T *a, int s, T *out, int os) {
+  const T *r0 = a, *r1 = a + s, *r2 = a + 2 * s, *r3 = a + 3 * s;
+  if (n == 2) {
+    out[0] = r1[1];
+    out[1] = -r1[0];
+    out[os] = -r0[1];
+    out[os + 1] = r0[0];
+  } else if (n == 3) {
+    // Cyclic row and column order gives every 2x2 minor its cofactor sign
+    for (int i = 0; i != 3; ++i) {
+      const T *p = a + (i + 1) % 3 * s, *q = a + (i + 2) % 3 * s;
+      for (int j = 0; j != 3; ++j) {
+        const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        out[i * os + j] = p[j1] * q[j2] - p[j2] * q[j1];
+      }
+    }
+  } else {
+    const T s0 = r0[0] * r1[1] - r1[0] * r0[1];
+    const T s1 = r0[0] * r1[2] - r1[0] * r0[2];
+    const T s2 = r0[0] * r1[3] - r1[0] * r0[3];
+    const T s3 = r0[1] * r1[2] - r1[1] * r0[2];
+    const T s4 = r0[1] * r1[3] - r1[1] * r0[3];
+    const T s5 = r0[2] * r1[3] - r1[2] * r0[3];
+    const T c5 = r2[2] * r3[3] - r3[2] * r2[3];
+    const T c4 = r2[1] * r3[3] - r3[1] * r2[3];
+    const T c3 = r2[1] * r3[2] - r3[1] * r2[2];
+    const T c2 = r2[0] * r3[3] - r3[0] * r2[3];
+    const T c1 = r2[0] * r3[2] - r3[0] * r2[2];
+    const T c0 = r2[0] * r3[1] - r3[0] * r2[1];
+    T *o0 = out, *o1 = out + os, *o2 = out + 2 * os, *o3 = out + 3 * os;
+    o0[0] = r1[1] * c5 - r1[2] * c4 + r1[3] * c3;
+    o1[0] = -r0[1] * c5 + r0[2] * c4 - r0[3] * c3;
+    o2[0] = r3[1] * s5 - r3[2] * s4 + r3[3] * s3;
+    o3[0] = -r2[1] * s5 + r2[2] * s4 - r2[3] * s3;
+    o0[1] = -r1[0] * c5 + r1[2] * c2 - r1[3] * c1;
+    o1[1] = r0[0] * c5 - r0[2] * c2 + r0[3] * c1;
+    o2[1] = -r3[0] * s5 + r3[2] * s2 - r3[3] * s1;
+    o3[1] = r2[0] * s5 - r2[2] * s2 + r2[3] * s1;
+    o0[2] = r1[0] * c4 - r1[1] * c2 + r1[3] * c0;
+    o1[2] = -r0[0] * c4 + r0[1] * c2 - r0[3] * c0;
+    o2[2] = r3[0] * s4 - r3[1] * s2 + r3[3] * s0;
+    o3[2] = -r2[0] * s4 + r2[1] * s2 - r2[3] * s0;
+    o0[3] = -r1[0] * c3 + r1[1] * c1 - r1[2] * c0;
+    o1[3] = r0[0] * c3 - r0[1] * c1 + r0[2] * c0;
+    o2[3] = -r3[0] * s3 + r3[1] * s1 - r3[2] * s0;
+    o3[3] = r2[0] * s3 - r2[1] * s1 + r2[2] * s0;
+  }
+}
+
+// Cache-oblivious transpose of a rows x cols block, dst(j, i) = src(i, j):
+// the longer side is halved until both fit in a leaf, so every level of the
+// cache sees blocks that fit in it whatever its size
+template <typename T>
+static void TransposeBlocked(const T *src, int ss, T *dst, int ds, int rows,
+                             int cols) {
+  if (rows <= kTransposeLeaf && cols <= kTransposeLeaf) {
+    for (int i = 0; i != rows; ++i) {
+      for (int j = 0; j != cols; ++j) dst[j * ds + i] = src[i * ss + j];
+    }
+  } else if (rows >= cols) {
+    const int half = rows / 2;
+    TransposeBlocked(src, ss, dst, ds, half, cols);
+    TransposeBlocked(src + half * ss, ss, dst + half, ds, rows - half, cols);
+  } else {
+    const int half = cols / 2;
+    TransposeBlocked(src, ss, dst, ds, rows, half);
+    TransposeBlocked(src + half, ss, dst + half * ds, ds, rows, cols - half);
+  }
+}
+
+// Swaps the rows x cols block a with the transpose of the cols x rows block
+// b of the same matrix, split the same way as TransposeBlocked
+template <typename T>
+static void SwapTransposed(T *a, T *b, int s, int rows, int cols) {
+  if (rows <= kTransposeLeaf && cols <= kTransposeLeaf) {
+    for (int i = 0; i != rows; ++i) {
+      for (int j = 0; j != cols; ++j) std::swap(a[i * s + j], b[j * s + i]);
+    }
+  } else if (rows >= cols) {
+    const int half = rows / 2;
+    SwapTransposed(a, b, s, half, cols);
+    SwapTransposed(a + half * s, b + half, s, rows - half, cols);
+  } else {
+    const int half = cols / 2;
+    SwapTransposed(a, b, s, rows, half);
+    SwapTransposed(a + half, b + half * s, s, rows, cols - half);
+  }
+}
+
+// In-place transpose of an n x n block: both diagonal quarters are
+// transposed on their own, the two off-diagonal ones trade places
+template <typename T>
+static void TransposeSquare(T *a, int s, int n) {
+  if (n <= kTransposeLeaf) {
+    for (int i = 0; i != n; ++i) {
+      for (int j = i + 1; j != n; ++j) std::swap(a[i * s + j], a[j * s + i]);
+    }
+  } else {
+    const int half = n / 2;
+    TransposeSquare(a, s, half);
+    TransposeSquare(a + half * s + half, s, n - half);
+    SwapTransposed(a + half, a + half * s, s, half, n - half);
+  }
+}
+
+template <typename T>
+static T *NewBlock(size_t size, bool &pooled) {
+  return static_cast<T *>(
+      S21BufferPool::Instance().Allocate(size * sizeof(T), pooled));
+}
+
+// Drops one reference to a block counted by refs, the last one or the only
+// owner of an uncounted block frees it
+template <typename T>
+static void ReleaseBlock(T *elements, size_t size, bool pooled,
+                         std::atomic<long> *refs) {
+  if (!refs || refs->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    S21BufferPool::Instance().Release(elements, size * sizeof(T), pooled);
+    delete refs;
+  }
+}
+
 // Default constructor
-S21Matrix::S21Matrix() : rows_(1), cols_(1) { InitMatrix(); }
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix()
+    : rows_(1),
+      cols_(1),
+      stride_(1),
+      scratch_(false),
+      cow_(false),
+      pooled_(false),
+      refs_(nullptr) {
+  InitMatrix();
+}
 
 // Constructor with parameters
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows),
+      cols_(cols),
+      stride_(cols),
+      scratch_(false),
+      cow_(false),
+      pooled_(false),
+      refs_(nullptr) {
   if (rows < 1 || cols < 1) {
     throw std::invalid_argument(
         "There should be more than 1 row and/or column.");
@@ -13,128 +320,273 @@ S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
 }
 
 // Copy constructor
-S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix &other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.cols_),
+      scratch_(false),
+      cow_(other.cow_),
+      pooled_(false),
+      refs_(nullptr) {
   if (&other != this) {
-    CopyMatrix(other);
+    if (other.refs_ && other.cow_)
+      ShareStorage(other);
+    else
+      CopyMatrix(other);
   }
 }
 
 // Move constructor
-S21Matrix::S21Matrix(S21Matrix &&other) noexcept
-    : rows_(0), cols_(0), matrix_(nullptr) {
-  rows_ = std::exchange(other.rows_, 0);
-  cols_ = std::exchange(other.cols_, 0);
-  matrix_ = std::exchange(other.matrix_, nullptr);
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix &&other) noexcept
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      scratch_(false),
+      cow_(other.cow_),
+      pooled_(false),
+      matrix_(nullptr),
+      refs_(nullptr) {
+  TakeStorage(other);
 }
 
-S21Matrix::~S21Matrix() { DeleteMatrix(); }
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() { DeleteMatrix(); }
 
-int S21Matrix::GetRows() const { return rows_; }
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const { return rows_; }
 
-int S21Matrix::GetCols() const { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const { return cols_; }
 
-void S21Matrix::SetRows(int rows) {
-  S21Matrix result(rows, cols_);
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int rows) {
+  S21BasicMatrix result(rows, cols_);
   int lastRow = rows_;
   if (rows < rows_) lastRow = rows;
   CopyExisting(result, lastRow, cols_);
-  *this = result;
+  *this = std::move(result);
 }
 
-void S21Matrix::SetCols(int cols) {
-  S21Matrix result(rows_, cols);
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int cols) {
+  S21BasicMatrix result(rows_, cols);
   int lastCol = cols_;
   if (cols < cols_) lastCol = cols;
   CopyExisting(result, rows_, lastCol);
-  *this = result;
+  *this = std::move(result);
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) const {
-  bool status = true;
-  if (MatricesMismatch(*this, other))
-    status = false;
-  else {
-    for (int i = 0; i != rows_; ++i) {
-      for (int j = 0; j != cols_; ++j) {
-        if (!DoublesEqual(matrix_[i][j], other.matrix_[i][j])) status = false;
-      }
-    }
-  }
-  return status;
+template <typename T>
+void S21BasicMatrix<T>::SetCopyOnWrite(bool enabled) {
+  cow_ = enabled;
+  TrackReferences();
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsCopyOnWrite() const { return cow_; }
+
+template <typename T>
+bool S21BasicMatrix<T>::IsShared() const {
+  return refs_ && refs_->load(std::memory_order_acquire) > 1;
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() const {
+  return S21BasicMatrixView<T>(matrix_, rows_, cols_, stride_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                               int cols) const {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::RowRange(int first, int count) const {
+  return View().RowRange(first, count);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::ColRange(int first, int count) const {
+  return View().ColRange(first, count);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Minor(int row, int col) const {
+  return View().Minor(row, col);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Transposed() const {
+  return View().Transposed();
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrixView<T> &other) const {
+  return S21ExprEqual(*this, other);
 }
 
-void S21Matrix::SumMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrixView<T> &other) {
   try {
     if (MatricesMismatch(*this, other))
       throw std::invalid_argument("The sizes of matrices must match.");
-    for (int i = 0; i != rows_; ++i) {
-      for (int j = 0; j != cols_; ++j) {
-        matrix_[i][j] += other.matrix_[i][j];
+    Detach();
+    if (other.ReadsTransposed(matrix_, matrix_ + rows_ * stride_)) {
+      SumMatrix(S21BasicMatrix(other));
+    } else if (other.IsBlock() && !other.IsTransposed()) {
+      for (int i = 0; i != rows_; ++i) {
+        S21TypedKernels<T>::Add(cols_, other.GetData() + i * other.GetStride(),
+                                matrix_ + i * stride_);
       }
+    } else {
+      S21ForEachTiled(rows_, cols_, [&](int i, int j) {
+        matrix_[i * stride_ + j] += other.Coeff(i, j);
+        return true;
+      });
     }
   } catch (std::invalid_argument const &err) {
     std::cout << err.what() << std::endl;
   }
 }
 
-void S21Matrix::SubMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrixView<T> &other) {
   try {
     if (MatricesMismatch(*this, other))
       throw std::invalid_argument("The sizes of matrices must match.");
-    for (int i = 0; i != rows_; ++i) {
-      for (int j = 0; j != cols_; ++j) {
-        matrix_[i][j] -= other.matrix_[i][j];
+    Detach();
+    if (other.ReadsTransposed(matrix_, matrix_ + rows_ * stride_)) {
+      SubMatrix(S21BasicMatrix(other));
+    } else if (other.IsBlock() && !other.IsTransposed()) {
+      for (int i = 0; i != rows_; ++i) {
+        S21TypedKernels<T>::Sub(cols_, other.GetData() + i * other.GetStride(),
+                                matrix_ + i * stride_);
       }
+    } else {
+      S21ForEachTiled(rows_, cols_, [&](int i, int j) {
+        matrix_[i * stride_ + j] -= other.Coeff(i, j);
+        return true;
+      });
     }
   } catch (std::invalid_argument const &err) {
     std::cout << err.what() << std::endl;
   }
 }
 
-void S21Matrix::MulNumber(const double num) {
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  Detach();
   for (int i = 0; i != rows_; ++i) {
-    for (int j = 0; j != cols_; ++j) {
-      matrix_[i][j] *= num;
-    }
+    S21TypedKernels<T>::Scale(cols_, num, matrix_ + i * stride_);
   }
 }
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrixView<T> &other,
+                                  int threads) {
   try {
-    if (cols_ != other.rows_)
+    if (cols_ != other.GetRows())
       throw std::invalid_argument("Wrong matrices sizes for multiplication.");
-    S21Matrix result(rows_, other.cols_);
-    for (int i = 0; i != rows_; ++i) {
-      for (int j = 0; j != other.cols_; ++j) {
-        for (int k = 0; k != cols_; ++k) {
-          result.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
-        }
+    S21BasicMatrix result(rows_, other.GetCols());
+    Gemm(1, *this, false, other, false, 0, result, threads);
+    *this = std::move(result);
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Gemm(T alpha, const S21BasicMatrixView<T> &a,
+                             bool transA, const S21BasicMatrixView<T> &b,
+                             bool transB, T beta, S21BasicMatrix &c,
+                             int threads) {
+  c.Detach();
+  const int m = transA ? a.GetCols() : a.GetRows();
+  const int k = transA ? a.GetRows() : a.GetCols();
+  const int n = transB ? b.GetRows() : b.GetCols();
+  const T *begin = c.matrix_, *end = c.matrix_ + c.rows_ * c.stride_;
+  const bool aliasA = a.GetData() >= begin && a.GetData() < end;
+  const bool aliasB = b.GetData() >= begin && b.GetData() < end;
+  try {
+    if ((transB ? b.GetCols() : b.GetRows()) != k || c.rows_ != m ||
+        c.cols_ != n)
+      throw std::invalid_argument("Wrong matrices sizes for multiplication.");
+    if (aliasA || !a.IsBlock()) {
+      // The destination is also an operand or the operand is a minor that
+      // has no stride, read it from a copy. Transposed blocks are read in
+      // place by flipping their flag
+      Gemm(alpha, S21BasicMatrix(a), transA, b, transB, beta, c, threads);
+    } else if (aliasB || !b.IsBlock()) {
+      Gemm(alpha, a, transA, S21BasicMatrix(b), transB, beta, c, threads);
+    } else {
+      if (beta == 0.0)
+        std::fill(c.matrix_, c.matrix_ + c.rows_ * c.stride_, 0.0);
+      else if (beta != 1.0)
+        c.MulNumber(beta);
+      if (alpha != 0.0 && k != 0) {
+        GemmUpdate(m, n, k, alpha,
+                   {a.GetData(), a.GetStride(), transA != a.IsTransposed()},
+                   {b.GetData(), b.GetStride(), transB != b.IsTransposed()},
+                   c.matrix_, c.stride_, threads);
       }
     }
-    *this = result;
   } catch (std::invalid_argument const &err) {
     std::cout << err.what() << std::endl;
   }
 }
 
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix transposed(cols_, rows_);
-  for (int i = 0; i != transposed.rows_; ++i) {
-    for (int j = 0; j != transposed.cols_; ++j) {
-      transposed.matrix_[i][j] = matrix_[j][i];
-    }
+template <typename T>
+void S21BasicMatrix<T>::GemmAccumulate(T alpha,
+                                       const S21BasicMatrixView<T> &a,
+                                       const S21BasicMatrixView<T> &b, T *c,
+                                       int ldc) {
+  const int k = a.GetCols();
+  if (alpha != 0.0 && k != 0) {
+    GemmUpdate(a.GetRows(), b.GetCols(), k, alpha,
+               {a.GetData(), a.GetStride(), a.IsTransposed()},
+               {b.GetData(), b.GetStride(), b.IsTransposed()}, c, ldc, 0);
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() {
+  return View().Transpose();
+}
+
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  if (rows_ == cols_) {
+    Detach();
+    TransposeSquare(matrix_, stride_, rows_);
+  } else {
+    *this = Transpose();
   }
-  return transposed;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
-  S21Matrix result(rows_, cols_);
+template <typename T>
+bool S21BasicMatrix<T>::IsSymmetric() const {
+  return rows_ == cols_ && S21ExprEqual(View(), Transposed());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
+  S21BasicMatrix result = S21BasicMatrix();
+  // Every minor's determinant reuses the same scratch memory
+  S21ScratchScope scope;
   try {
+    if (rows_ < 1) throw std::invalid_argument("Matrix is empty.");
     if (rows_ != cols_) throw std::invalid_argument("Matrix must be square.");
     if (rows_ == 1)
       throw std::invalid_argument("There must be more than 1 row and column.");
-    Complements(result);
+    result = S21BasicMatrix(rows_, cols_);
+    if (rows_ <= kClosedFormMaxSize)
+      SmallComplements(rows_, matrix_, stride_, result.matrix_,
+                       result.stride_);
+    else
+      Complements(result);
   } catch (std::invalid_argument const &err) {
     std::cout << err.what() << std::endl;
     result.DeleteMatrix();
@@ -142,29 +594,56 @@ S21Matrix S21Matrix::CalcComplements() {
   return result;
 }
 
-double S21Matrix::Determinant() {
-  double det = 0.0;
-  try {
-    if (rows_ != cols_) throw std::invalid_argument("Matrix must be square.");
-    det = DetHelper();
-  } catch (std::invalid_argument const &err) {
-    std::cout << err.what() << std::endl;
-  }
-  return det;
+template <typename T>
+T S21BasicMatrix<T>::Determinant() {
+  return View().Determinant();
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
-  S21Matrix inversed = S21Matrix();
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() {
+  S21BasicMatrix inversed = S21BasicMatrix();
+  S21ScratchScope scope;
   if (rows_ == 1 && cols_ == 1) {
-    inversed(0, 0) = 1 / matrix_[0][0];
+    inversed(0, 0) = 1 / matrix_[0];
   } else {
-    inversed = CalcComplements().Transpose();
     try {
-      double det = Determinant();
-      if (fabs(det) <= 1.0e-7)
-        throw std::invalid_argument(
-            "Cannot inverse a matrix with 0 determinant.");
-      inversed *= (1.0 / det);
+      if (rows_ < 1) throw std::invalid_argument("Matrix is empty.");
+      if (rows_ != cols_) throw std::invalid_argument("Matrix must be square.");
+      if (rows_ <= kClosedFormMaxSize) {
+        // Inverse is the transposed matrix of complements over determinant
+        T det = SmallDeterminant(rows_, matrix_, stride_);
+        if (std::abs(det) <= S21Tolerance<T>::kValue)
+          throw std::invalid_argument(
+              "Cannot inverse a matrix with 0 determinant.");
+        T complements[kClosedFormMaxSize * kClosedFormMaxSize];
+        SmallComplements(rows_, matrix_, stride_, complements,
+                         kClosedFormMaxSize);
+        const T factor = 1.0 / det;
+        inversed = S21BasicMatrix(rows_, cols_);
+        for (int i = 0; i != rows_; ++i) {
+          for (int j = 0; j != cols_; ++j) {
+            inversed.matrix_[i * inversed.stride_ + j] =
+                complements[j * kClosedFormMaxSize + i] * factor;
+          }
+        }
+      } else {
+        bool positive = false;
+        if (ExactlySymmetric(rows_, matrix_, stride_)) {
+          // Only symmetric positive definite matrices stay on the Cholesky
+          // fast path. The factorization gives up as soon as a diagonal
+          // element of the trailing matrix is not positive, so indefinite
+          // input falls back to Gauss-Jordan after part of the factorization
+          S21BasicMatrix factors = Scratch(rows_, cols_);
+          factors = *this;
+          S21BasicCholesky<T> cholesky(std::move(factors));
+          positive = cholesky.IsPositiveDefinite();
+          if (positive) inversed = cholesky.Inverse();
+        }
+        if (!positive) {
+          inversed = S21BasicMatrix(rows_, cols_);
+          GaussJordan(inversed);
+        }
+      }
     } catch (std::invalid_argument const &err) {
       std::cout << err.what() << std::endl;
       inversed.DeleteMatrix();
@@ -173,184 +652,444 @@ S21Matrix S21Matrix::InverseMatrix() {
   return inversed;
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix &other) {
-  S21Matrix result(*this);
-  result.SumMatrix(other);
-  return result;
-}
-
-S21Matrix S21Matrix::operator-(const S21Matrix &other) {
-  S21Matrix result(*this);
-  result.SubMatrix(other);
-  return result;
-}
-
-S21Matrix S21Matrix::operator*(const S21Matrix &other) {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
-  return result;
-}
-
-S21Matrix S21Matrix::operator*(const double num) {
-  S21Matrix result(*this);
-  result.MulNumber(num);
-  return result;
-}
-
-bool S21Matrix::operator==(const S21Matrix &other) const {
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix &other) const {
   return EqMatrix(other);
 }
 
-S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21BasicMatrix &other) {
   if (this != &other) {
-    DeleteMatrix();
-    rows_ = other.rows_;
-    cols_ = other.cols_;
-    CopyMatrix(other);
+    if (other.refs_ && other.cow_ && !scratch_) {
+      if (matrix_ != other.matrix_) {
+        DeleteMatrix();
+        ShareStorage(other);
+      }
+    } else if (matrix_ && rows_ == other.rows_ && cols_ == other.cols_ &&
+               !IsShared()) {
+      // Same shape: overwrite the existing block instead of reallocating
+      for (int i = 0; i != rows_; ++i) {
+        std::copy(other.matrix_ + i * other.stride_,
+                  other.matrix_ + i * other.stride_ + cols_,
+                  matrix_ + i * stride_);
+      }
+    } else {
+      DeleteMatrix();
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      CopyMatrix(other);
+    }
   }
   return *this;
 }
 
-S21Matrix &S21Matrix::operator=(S21Matrix &&other) noexcept {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(
+    S21BasicMatrix &&other) noexcept {
   if (this != &other) {
     DeleteMatrix();
-    rows_ = std::exchange(other.rows_, 0);
-    cols_ = std::exchange(other.cols_, 0);
-    matrix_ = std::exchange(other.matrix_, nullptr);
+    TakeStorage(other);
   }
   return *this;
 }
 
-S21Matrix S21Matrix::operator+=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(
+    const S21BasicMatrix &other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator-=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(
+    const S21BasicMatrix &other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator*=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(
+    const S21BasicMatrix &other) {
   MulMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator*=(const double num) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const T num) {
   MulNumber(num);
   return *this;
 }
 
-double &S21Matrix::operator()(int row, int col) {
+template <typename T>
+T &S21BasicMatrix<T>::operator()(int row, int col) {
   CheckIndices(row, col);
-  return matrix_[row][col];
+  Detach();
+  return matrix_[row * stride_ + col];
 }
 
-double &S21Matrix::operator()(int row, int col) const {
+template <typename T>
+const T &S21BasicMatrix<T>::operator()(int row, int col) const {
   CheckIndices(row, col);
-  return matrix_[row][col];
+  return matrix_[row * stride_ + col];
 }
 
-// Allocate memory and fill it with 0
-void S21Matrix::InitMatrix() {
-  matrix_ = new double *[rows_]();
-  for (int i = 0; i != rows_; ++i) {
-    matrix_[i] = new double[cols_]();
+// Allocate memory and fill it with 0, small matrices use the inline buffer
+template <typename T>
+void S21BasicMatrix<T>::InitMatrix() {
+  stride_ = cols_;
+  const size_t size = static_cast<size_t>(rows_) * stride_;
+  if (size <= kInlineCapacity) {
+    matrix_ = inline_;
+    std::fill(matrix_, matrix_ + size, 0.0);
+  } else {
+    matrix_ = NewBlock<T>(size, pooled_);
+    std::fill(matrix_, matrix_ + size, 0.0);
+    TrackReferences();
   }
 }
 
 // Free the memory
-void S21Matrix::DeleteMatrix() {
-  if (matrix_) {
-    for (int i = 0; i != rows_; ++i) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
-    matrix_ = nullptr;
+template <typename T>
+void S21BasicMatrix<T>::DeleteMatrix() {
+  if (OwnsHeapBlock()) {
+    ReleaseBlock(matrix_, static_cast<size_t>(rows_) * stride_, pooled_,
+                 refs_);
   }
+  matrix_ = nullptr;
+  refs_ = nullptr;
+  scratch_ = false;
+  pooled_ = false;
   rows_ = 0;
   cols_ = 0;
+  stride_ = 0;
 }
 
-void S21Matrix::CopyMatrix(const S21Matrix &other) {
-  InitMatrix();
-  for (int i = 0; i != rows_; ++i) {
-    for (int j = 0; j != cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
+// Moves other's elements into an empty matrix: a heap block is stolen, an
+// inline one has to be copied since it lives inside other
+template <typename T>
+void S21BasicMatrix<T>::TakeStorage(S21BasicMatrix &other) noexcept {
+  rows_ = std::exchange(other.rows_, 0);
+  cols_ = std::exchange(other.cols_, 0);
+  stride_ = std::exchange(other.stride_, 0);
+  scratch_ = std::exchange(other.scratch_, false);
+  pooled_ = std::exchange(other.pooled_, false);
+  if (other.matrix_ == other.inline_) {
+    std::copy(other.inline_, other.inline_ + rows_ * stride_, inline_);
+    matrix_ = inline_;
+    other.matrix_ = nullptr;
+  } else {
+    matrix_ = std::exchange(other.matrix_, nullptr);
+    refs_ = std::exchange(other.refs_, nullptr);
+    TrackReferences();
   }
 }
 
-void S21Matrix::CopyExisting(S21Matrix &result, int rows, int cols) {
-  for (int i = 0; i != rows; ++i) {
-    for (int j = 0; j != cols; ++j) {
-      result.matrix_[i][j] = matrix_[i][j];
-    }
+// Takes one more reference to other's heap block, the matrix must be empty
+template <typename T>
+void S21BasicMatrix<T>::ShareStorage(const S21BasicMatrix &other) noexcept {
+  other.refs_->fetch_add(1, std::memory_order_relaxed);
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  pooled_ = other.pooled_;
+  matrix_ = other.matrix_;
+  refs_ = other.refs_;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::OwnsHeapBlock() const {
+  return matrix_ && matrix_ != inline_ && !scratch_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Detach() {
+  if (IsShared()) {
+    const size_t size = static_cast<size_t>(rows_) * stride_;
+    bool pooled = false;
+    T *elements = NewBlock<T>(size, pooled);
+    std::copy(matrix_, matrix_ + size, elements);
+    ReleaseBlock(matrix_, size, pooled_, refs_);
+    matrix_ = elements;
+    pooled_ = pooled;
+    refs_ = nullptr;
+    TrackReferences();
   }
 }
 
-bool S21Matrix::DoublesEqual(double a, double b) const {
-  return (fabs(a - b) >= 1.0e-07) ? false : true;
+// Without memory for the count the block stays uncounted and copies of the
+// matrix are deep
+template <typename T>
+void S21BasicMatrix<T>::TrackReferences() noexcept {
+  if (cow_ && !refs_ && OwnsHeapBlock())
+    refs_ = new (std::nothrow) std::atomic<long>(1);
 }
 
-bool S21Matrix::MatricesMismatch(const S21Matrix &a, const S21Matrix &b) const {
-  return ((a.rows_ != b.rows_) || (a.cols_ != b.cols_)) ? true : false;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Scratch(int rows, int cols) {
+  S21BasicMatrix result;
+  const size_t size = static_cast<size_t>(rows) * cols;
+  result.rows_ = rows;
+  result.cols_ = cols;
+  result.stride_ = cols;
+  if (size > kInlineCapacity) {
+    result.matrix_ = S21ScratchArena::Local().Allocate<T>(size);
+    result.scratch_ = true;
+  }
+  std::fill(result.matrix_, result.matrix_ + size, 0.0);
+  return result;
 }
 
-void S21Matrix::Complements(S21Matrix &result) {
-  for (int i = 0; i != rows_; ++i) {
-    for (int j = 0; j != cols_; ++j) {
-      S21Matrix minor(rows_ - 1, cols_ - 1);
-      Minor(minor, i, j);
-      result.matrix_[i][j] = pow(-1, (i + j)) * minor.Determinant();
-      minor.DeleteMatrix();
+template <typename T>
+void S21BasicMatrix<T>::CopyMatrix(const S21BasicMatrix &other) {
+  InitMatrix();
+  if (other.stride_ == stride_) {
+    std::copy(other.matrix_,
+              other.matrix_ + static_cast<size_t>(rows_) * stride_, matrix_);
+  } else {
+    for (int i = 0; i != rows_; ++i) {
+      std::copy(other.matrix_ + i * other.stride_,
+                other.matrix_ + i * other.stride_ + cols_,
+                matrix_ + i * stride_);
     }
   }
 }
 
-void S21Matrix::Minor(S21Matrix &minor, int row, int col) {
-  int rowCnt = 0, colCnt = 0;
+template <typename T>
+void S21BasicMatrix<T>::CopyExisting(S21BasicMatrix &result, int rows,
+                                     int cols) {
+  for (int i = 0; i != rows; ++i) {
+    std::copy(matrix_ + i * stride_, matrix_ + i * stride_ + cols,
+              result.matrix_ + i * result.stride_);
+  }
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::MatricesMismatch(
+    const S21BasicMatrixView<T> &a, const S21BasicMatrixView<T> &b) const {
+  return ((a.GetRows() != b.GetRows()) || (a.GetCols() != b.GetCols()))
+             ? true
+             : false;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Complements(S21BasicMatrix &result) {
   for (int i = 0; i != rows_; ++i) {
-    if (i != row) {
-      colCnt = 0;
-      for (int j = 0; j != cols_; ++j) {
-        if (j != col) {
-          minor.matrix_[rowCnt][colCnt] = matrix_[i][j];
-          ++colCnt;
-        }
-      }
-      ++rowCnt;
+    for (int j = 0; j != cols_; ++j) {
+      result.matrix_[i * result.stride_ + j] =
+          ((i + j) % 2 ? -1.0 : 1.0) * Minor(i, j).Determinant();
     }
   }
 }
 
-double S21Matrix::DetHelper() {
-  double result = 0.0;
-  if (rows_ == 1)
-    result = matrix_[0][0];
-  else if (rows_ == 2) {
-    result = matrix_[0][0] * matrix_[1][1] - matrix_[1][0] * matrix_[0][1];
-  } else {
-    for (int j = 0; j != cols_; ++j) {
-      S21Matrix minor(rows_ - 1, cols_ - 1);
-      Minor(minor, 0, j);
-      result += matrix_[0][j] * pow(-1, j) * minor.DetHelper();
-      minor.DeleteMatrix();
+// Gauss-Jordan elimination with partial pivoting: the row operations that
+// reduce a scratch copy of the matrix to identity turn identity into inverse
+template <typename T>
+void S21BasicMatrix<T>::GaussJordan(S21BasicMatrix &inversed) const {
+  S21ScratchScope scope;
+  S21BasicMatrix work = Scratch(rows_, cols_);
+  work = *this;
+  const int n = rows_, ws = work.stride_, is = inversed.stride_;
+  T *a = work.matrix_, *inv = inversed.matrix_;
+  for (int i = 0; i != n; ++i) inv[i * is + i] = 1.0;
+  for (int k = 0; k != n; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i != n; ++i) {
+      if (std::abs(a[i * ws + k]) > std::abs(a[pivot * ws + k])) pivot = i;
+    }
+    if (std::abs(a[pivot * ws + k]) <= S21Tolerance<T>::kValue)
+      throw std::invalid_argument(
+          "Cannot inverse a matrix with 0 determinant.");
+    if (pivot != k) {
+      std::swap_ranges(a + k * ws + k, a + k * ws + n, a + pivot * ws + k);
+      std::swap_ranges(inv + k * is, inv + k * is + n, inv + pivot * is);
+    }
+    T *rowK = a + k * ws, *invK = inv + k * is;
+    const T scale = 1.0 / rowK[k];
+    for (int j = k + 1; j != n; ++j) rowK[j] *= scale;
+    for (int j = 0; j != n; ++j) invK[j] *= scale;
+    for (int i = 0; i != n; ++i) {
+      const T factor = a[i * ws + k];
+      if (i != k && factor != 0.0) {
+        T *rowI = a + i * ws, *invI = inv + i * is;
+        for (int j = k + 1; j != n; ++j) rowI[j] -= factor * rowK[j];
+        for (int j = 0; j != n; ++j) invI[j] -= factor * invK[j];
+      }
     }
   }
-  return result;
 }
 
-void S21Matrix::CheckIndices(int row, int col) const {
+template <typename T>
+void S21BasicMatrix<T>::CheckIndices(int row, int col) const {
+  // One unsigned comparison per index covers both bounds, the messages are
+  // only picked on the way out
+  if (static_cast<unsigned>(row) < static_cast<unsigned>(rows_) &&
+      static_cast<unsigned>(col) < static_cast<unsigned>(cols_))
+    return;
   if (row < 0)
     throw std::invalid_argument("Row index cannot be less than 0.");
-  else if (row > rows_)
+  else if (row >= rows_)
     throw std::invalid_argument(
         "Row index is greater than actual amount of rows in the matrix.");
   else if (col < 0)
     throw std::invalid_argument("Column index cannot be less than 0.");
-  else if (col > cols_)
+  else
     throw std::invalid_argument(
         "Column index is greater than actual amount of columns in the "
         "matrix.");
-}
\ No newline at end of file
+}
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(const T *data, int rows, int cols,
+                                          int stride)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      stride_(stride),
+      skipRow_(rows),
+      skipCol_(cols),
+      transposed_(false) {}
+
+template <typename T>
+int S21BasicMatrixView<T>::GetRows() const { return rows_; }
+
+template <typename T>
+int S21BasicMatrixView<T>::GetCols() const { return cols_; }
+
+template <typename T>
+bool S21BasicMatrixView<T>::IsBlock() const {
+  return skipRow_ == rows_ && skipCol_ == cols_;
+}
+
+template <typename T>
+bool S21BasicMatrixView<T>::IsTransposed() const { return transposed_; }
+
+template <typename T>
+const T *S21BasicMatrixView<T>::GetData() const { return data_; }
+
+template <typename T>
+int S21BasicMatrixView<T>::GetStride() const { return stride_; }
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Block(int row, int col, int rows,
+                                                   int cols) const {
+  if (!IsBlock())
+    throw std::invalid_argument("Cannot take a block of a minor.");
+  if (row < 0 || col < 0 || rows < 1 || cols < 1 || row + rows > rows_ ||
+      col + cols > cols_)
+    throw std::invalid_argument("The block is outside the matrix.");
+  S21BasicMatrixView block(data_ + (transposed_ ? col * stride_ + row
+                                                : row * stride_ + col),
+                           rows, cols, stride_);
+  block.transposed_ = transposed_;
+  return block;
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::RowRange(int first,
+                                                      int count) const {
+  return Block(first, 0, count, cols_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::ColRange(int first,
+                                                      int count) const {
+  return Block(0, first, rows_, count);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Minor(int row, int col) const {
+  if (!IsBlock())
+    throw std::invalid_argument("Cannot take a minor of a minor.");
+  if (rows_ < 2 || cols_ < 2)
+    throw std::invalid_argument("There must be more than 1 row and column.");
+  CheckIndices(row, col);
+  S21BasicMatrixView minor(*this);
+  minor.rows_ = rows_ - 1;
+  minor.cols_ = cols_ - 1;
+  minor.skipRow_ = row;
+  minor.skipCol_ = col;
+  return minor;
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Transposed() const {
+  S21BasicMatrixView transposed(*this);
+  std::swap(transposed.rows_, transposed.cols_);
+  std::swap(transposed.skipRow_, transposed.skipCol_);
+  transposed.transposed_ = !transposed_;
+  return transposed;
+}
+
+template <typename T>
+bool S21BasicMatrixView<T>::EqMatrix(const S21BasicMatrixView &other) const {
+  return S21ExprEqual(*this, other);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixView<T>::Transpose() const {
+  S21BasicMatrix<T> transposed(cols_, rows_);
+  T *dst = transposed.matrix_;
+  const int ds = transposed.stride_;
+  if (IsBlock() && !transposed_) {
+    TransposeBlocked(data_, stride_, dst, ds, rows_, cols_);
+  } else if (IsBlock()) {
+    // The storage of a transposed view already is the result
+    for (int i = 0; i != cols_; ++i) {
+      std::copy(data_ + i * stride_, data_ + i * stride_ + rows_, dst + i * ds);
+    }
+  } else {
+    S21ForEachTiled(cols_, rows_, [&](int i, int j) {
+      dst[i * ds + j] = Coeff(j, i);
+      return true;
+    });
+  }
+  return transposed;
+}
+
+template <typename T>
+T S21BasicMatrixView<T>::Determinant() const {
+  T det = 0.0;
+  try {
+    if (rows_ < 1) throw std::invalid_argument("Matrix is empty.");
+    if (rows_ != cols_) throw std::invalid_argument("Matrix must be square.");
+    // Closed forms are exact for small matrices, LU is O(n^3) for the rest.
+    // The elements of a small minor are gathered first to get a stride, a
+    // transposed block has the determinant of its storage
+    if (rows_ <= kClosedFormMaxSize && IsBlock()) {
+      det = SmallDeterminant(rows_, data_, stride_);
+    } else if (rows_ <= kClosedFormMaxSize) {
+      T block[kClosedFormMaxSize * kClosedFormMaxSize];
+      for (int i = 0; i != rows_; ++i) {
+        for (int j = 0; j != cols_; ++j) block[i * cols_ + j] = Coeff(i, j);
+      }
+      det = SmallDeterminant(rows_, block, cols_);
+    } else {
+      S21ScratchScope scope;
+      S21BasicMatrix<T> work = S21BasicMatrix<T>::Scratch(rows_, cols_);
+      work = *this;
+      det = S21BasicLU<T>::FactorizeDeterminant(work);
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+  return det;
+}
+
+template <typename T>
+const T &S21BasicMatrixView<T>::operator()(int row, int col) const {
+  CheckIndices(row, col);
+  return *Address(row, col);
+}
+
+template <typename T>
+void S21BasicMatrixView<T>::CheckIndices(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw std::invalid_argument("Index is outside the matrix.");
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+
+template class S21BasicMatrixView<float>;
+template class S21BasicMatrixView<double>;
+template class S21BasicMatrixView<long double>;
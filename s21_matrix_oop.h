@@ -1,66 +1,390 @@
 #ifndef S21_MATRIX_OOP_H
 #define S21_MATRIX_OOP_H
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_view.h"
+#include "s21_span.h"
+
+template <typename T>
+class S21BasicLU;
+template <typename T>
+class S21BasicCholesky;
+template <typename T>
+class S21BasicQR;
+template <typename T>
+class S21BasicSparseMatrix;
+template <typename T>
+class S21BasicSymmetricMatrix;
+template <typename T>
+class S21BasicTriangularMatrix;
+template <typename T>
+class S21BasicBandMatrix;
+template <typename T>
+class S21BasicBandLU;
+
+// Dense matrix of float, double or long double elements. Members are defined
+// in s21_matrix_oop.cc and instantiated there for these three types only
+template <typename T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T>> {
+  template <typename>
+  friend class S21BasicLU;
+  template <typename>
+  friend class S21BasicCholesky;
+  template <typename>
+  friend class S21BasicQR;
+  template <typename>
+  friend class S21BasicMatrixView;
+  template <typename>
+  friend class S21BasicSparseMatrix;
+  template <typename>
+  friend class S21BasicSymmetricMatrix;
+  template <typename>
+  friend class S21BasicTriangularMatrix;
+  template <typename>
+  friend class S21BasicBandMatrix;
+  template <typename>
+  friend class S21BasicBandLU;
 
-class S21Matrix {
  private:
-  int rows_, cols_;
-  double **matrix_;
+  // Elements are kept in one contiguous row-major block, element (i, j) lives
+  // at matrix_[i * stride_ + j]. Matrices up to 4x4 point matrix_ at inline_
+  // and never touch the heap. scratch_ marks a block in the thread's
+  // S21ScratchArena, which is not freed with the matrix. pooled_ is the flag
+  // S21BufferPool gave the heap block. Copies of a matrix with cow_ set share
+  // its heap block, refs_ then counts the matrices using it. It is allocated
+  // apart from the elements and only for such blocks, nullptr means the
+  // matrix is the only owner
+  static constexpr int kInlineCapacity = 16;
+  int rows_, cols_, stride_;
+  bool scratch_, cow_, pooled_;
+  T *matrix_;
+  std::atomic<long> *refs_;
+  T inline_[kInlineCapacity];
   // Helper functions
   void InitMatrix();
   void DeleteMatrix();
-  void CopyMatrix(const S21Matrix &other);
-  void CopyExisting(S21Matrix &result, int rows, int cols);
-  bool DoublesEqual(double a, double b) const;
-  bool MatricesMismatch(const S21Matrix &a, const S21Matrix &b) const;
-  void Complements(S21Matrix &result);
-  void Minor(S21Matrix &minor, int rows, int cols);
-  double DetHelper();
+  void TakeStorage(S21BasicMatrix &other) noexcept;
+  void ShareStorage(const S21BasicMatrix &other) noexcept;
+  bool OwnsHeapBlock() const;
+  // Gives the heap block of a copy-on-write matrix its reference count
+  void TrackReferences() noexcept;
+  // Gives the matrix its own copy of shared elements before they change
+  void Detach();
+  void CopyMatrix(const S21BasicMatrix &other);
+  void CopyExisting(S21BasicMatrix &result, int rows, int cols);
+  bool MatricesMismatch(const S21BasicMatrixView<T> &a,
+                        const S21BasicMatrixView<T> &b) const;
+  void Complements(S21BasicMatrix &result);
+  void GaussJordan(S21BasicMatrix &inversed) const;
   void CheckIndices(int row, int col) const;
+  void DebugCheckIndices([[maybe_unused]] int row,
+                         [[maybe_unused]] int col) const {
+#ifdef S21_MATRIX_DEBUG
+    CheckIndices(row, col);
+#endif
+  }
+  template <typename E>
+  void Assign(const E &expr);
+  // Zero matrix for the temporaries of an operation, a larger one lives in
+  // S21ScratchArena and must be destroyed before the innermost open
+  // S21ScratchScope ends
+  static S21BasicMatrix Scratch(int rows, int cols);
+  // c += alpha * a * b on the blocked product, c has row stride ldc and may
+  // be rows of a larger matrix. a and b must be blocks, read transposed if
+  // they are, and must not overlap c
+  static void GemmAccumulate(T alpha, const S21BasicMatrixView<T> &a,
+                             const S21BasicMatrixView<T> &b, T *c, int ldc);
 
  public:
+  using value_type = T;
+
   // Constructors and a destructor
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix &other);
-  S21Matrix(S21Matrix &&other) noexcept;
-  ~S21Matrix();
+  S21BasicMatrix();
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix(S21BasicMatrix &&other) noexcept;
+  // Evaluates a lazy expression such as a + b - c * 2.0 in a single pass
+  template <typename E>
+  S21BasicMatrix(const S21MatrixExpr<E> &expr);
+  ~S21BasicMatrix();
 
   // Getters and setters for private fields
   int GetRows() const;
   int GetCols() const;
   void SetRows(int rows);
   void SetCols(int cols);
+  // Copy-on-write: copies of a matrix with this mode share its elements
+  // instead of copying them, and the first change to any of the matrices
+  // gives it its own copy. Copies keep the mode, assignments leave the mode
+  // of the target as it is. Reference counts are atomic, so the copies may
+  // be read and changed from different threads
+  void SetCopyOnWrite(bool enabled);
+  bool IsCopyOnWrite() const;
+  // Whether another matrix shares the elements
+  bool IsShared() const;
+
+  // Views of the elements, see s21_matrix_view.h. A matrix converts to a
+  // view of itself, so every operand below may also be a block or a minor
+  S21BasicMatrixView<T> View() const;
+  S21BasicMatrixView<T> Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView<T> RowRange(int first, int count) const;
+  S21BasicMatrixView<T> ColRange(int first, int count) const;
+  S21BasicMatrixView<T> Minor(int row, int col) const;
+  S21BasicMatrixView<T> Transposed() const;
+  operator S21BasicMatrixView<T>() const { return View(); }
 
   // Operations
-  bool EqMatrix(const S21Matrix &other) const;
-  void SumMatrix(const S21Matrix &other);
-  void SubMatrix(const S21Matrix &other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix &other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
-
-  // Operators
-  S21Matrix operator+(const S21Matrix &other);
-  S21Matrix operator-(const S21Matrix &other);
-  S21Matrix operator*(const S21Matrix &other);
-  S21Matrix operator*(const double num);
-  bool operator==(const S21Matrix &other) const;
-  S21Matrix &operator=(const S21Matrix &other);
-  S21Matrix &operator=(S21Matrix &&other) noexcept;
-  S21Matrix operator+=(const S21Matrix &other);
-  S21Matrix operator-=(const S21Matrix &other);
-  S21Matrix operator*=(const S21Matrix &other);
-  S21Matrix operator*=(const double num);
-  double &operator()(int row, int col);
-  double &operator()(int row, int col) const;
+  bool EqMatrix(const S21BasicMatrixView<T> &other) const;
+  void SumMatrix(const S21BasicMatrixView<T> &other);
+  void SubMatrix(const S21BasicMatrixView<T> &other);
+  void MulNumber(const T num);
+  // threads limits the thread pool for this call, 1 keeps it on the caller
+  void MulMatrix(const S21BasicMatrixView<T> &other, int threads = 0);
+  // c = alpha * op(a) * op(b) + beta * c in place, op(x) reads x transposed
+  // when its flag is set without building the transposed matrix
+  static void Gemm(T alpha, const S21BasicMatrixView<T> &a, bool transA,
+                   const S21BasicMatrixView<T> &b, bool transB, T beta,
+                   S21BasicMatrix &c, int threads = 0);
+  // Transposed copy made by cache-oblivious blocking, Transposed() gives a
+  // lazy view instead
+  S21BasicMatrix Transpose();
+  // Square matrices are transposed without a second buffer
+  void TransposeInPlace();
+  // Square and equal to its transpose within the tolerance, stops at the
+  // first pair of elements that differ
+  bool IsSymmetric() const;
+  S21BasicMatrix CalcComplements();
+  T Determinant();
+  S21BasicMatrix InverseMatrix();
+
+  // Operators, +, - and multiplication by a number are lazy and declared in
+  // s21_matrix_expr.h, the matrix product and the forms that reuse a
+  // temporary operand are declared below the class
+  bool operator==(const S21BasicMatrix &other) const;
+  S21BasicMatrix &operator=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator=(S21BasicMatrix &&other) noexcept;
+  template <typename E>
+  S21BasicMatrix &operator=(const S21MatrixExpr<E> &expr);
+  S21BasicMatrix &operator+=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator-=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(const T num);
+  // Checked in every build, a wrong index throws std::invalid_argument; At()
+  // below is the access whose checks exist only with S21_MATRIX_DEBUG. A
+  // reference from the non-const form is only valid until the matrix is
+  // copied, a copy-on-write copy would see later writes through it
+  T &operator()(int row, int col);
+  const T &operator()(int row, int col) const;
+
+  // Unchecked element access, a wrong index only throws like operator() in
+  // builds with S21_MATRIX_DEBUG defined. The non-const forms detach a
+  // shared matrix on every call, so a hot loop should take a row, data() or
+  // the iterators once before it
+  T &At(int row, int col) {
+    DebugCheckIndices(row, col);
+    Detach();
+    return matrix_[row * stride_ + col];
+  }
+  const T &At(int row, int col) const {
+    DebugCheckIndices(row, col);
+    return matrix_[row * stride_ + col];
+  }
+  // Elements in row-major order without gaps, GetRows() * GetCols() of them
+  T *data() {
+    Detach();
+    return matrix_;
+  }
+  const T *data() const { return matrix_; }
+  S21Span<T> Row(int row) {
+    DebugCheckIndices(row, 0);
+    return S21Span<T>(data() + row * stride_, cols_);
+  }
+  S21Span<const T> Row(int row) const {
+    DebugCheckIndices(row, 0);
+    return S21Span<const T>(matrix_ + row * stride_, cols_);
+  }
+  // Random access iterators over all elements in row-major order, for the
+  // standard algorithms and their parallel forms
+  using iterator = T *;
+  using const_iterator = const T *;
+  iterator begin() { return data(); }
+  iterator end() { return data() + static_cast<size_t>(rows_) * cols_; }
+  const_iterator begin() const { return matrix_; }
+  const_iterator end() const {
+    return matrix_ + static_cast<size_t>(rows_) * cols_;
+  }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // Unchecked element read used when evaluating expressions
+  T Coeff(int row, int col) const { return matrix_[row * stride_ + col]; }
+  bool ReadsTransposed(const T *, const T *) const { return false; }
 };
 
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixLD = S21BasicMatrix<long double>;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E> &expr)
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      scratch_(false),
+      cow_(false),
+      pooled_(false),
+      matrix_(nullptr),
+      refs_(nullptr) {
+  Assign(expr.Derived());
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21MatrixExpr<E> &expr) {
+  Assign(expr.Derived());
+  return *this;
+}
+
+// Element (i, j) of an expression only reads element (i, j) of its operands,
+// so a matrix of the right size can be overwritten even if it is one of them.
+// A transposed view of the matrix itself is the exception, and shared
+// elements are never overwritten
+template <typename T>
+template <typename E>
+void S21BasicMatrix<T>::Assign(const E &expr) {
+  static_assert(std::is_same<typename E::value_type, T>::value,
+                "Operands must have the same element type.");
+  const int rows = expr.GetRows(), cols = expr.GetCols();
+  if (rows < 1 || cols < 1) {
+    DeleteMatrix();
+  } else if (!matrix_ || rows != rows_ || cols != cols_ || IsShared() ||
+             expr.ReadsTransposed(matrix_, matrix_ + rows_ * stride_)) {
+    S21BasicMatrix result(rows, cols);
+    result.Assign(expr);
+    *this = std::move(result);
+  } else {
+    S21ForEachTiled(rows_, cols_, [&](int i, int j) {
+      matrix_[i * stride_ + j] = expr.Coeff(i, j);
+      return true;
+    });
+  }
+}
+
+// Product of two matrices or views, with the result of MulMatrix: operands
+// of wrong sizes print an error and give a copy of the left one
+template <typename T>
+S21BasicMatrix<T> S21MatrixProduct(const S21BasicMatrixView<T> &a,
+                                   const S21BasicMatrixView<T> &b) {
+  if (a.GetCols() != b.GetRows()) {
+    S21BasicMatrix<T> result(a);
+    result.MulMatrix(b);
+    return result;
+  }
+  S21BasicMatrix<T> result(a.GetRows(), b.GetCols());
+  S21BasicMatrix<T>::Gemm(1, a, false, b, false, 0, result);
+  return result;
+}
+
+// Matrix products are not lazy. Matrices and views are multiplied straight
+// from their elements, other expression operands are evaluated first
+template <typename L, typename R>
+S21BasicMatrix<typename L::value_type> operator*(const S21MatrixExpr<L> &lhs,
+                                                 const S21MatrixExpr<R> &rhs) {
+  using T = typename L::value_type;
+  using View = S21BasicMatrixView<T>;
+  constexpr bool lhsView = std::is_convertible<L, View>::value;
+  constexpr bool rhsView = std::is_convertible<R, View>::value;
+  if constexpr (lhsView && rhsView)
+    return S21MatrixProduct<T>(lhs.Derived(), rhs.Derived());
+  else if constexpr (lhsView)
+    return S21MatrixProduct<T>(lhs.Derived(), S21BasicMatrix<T>(rhs));
+  else if constexpr (rhsView)
+    return S21MatrixProduct<T>(S21BasicMatrix<T>(lhs), rhs.Derived());
+  else
+    return S21MatrixProduct<T>(S21BasicMatrix<T>(lhs), S21BasicMatrix<T>(rhs));
+}
+
+// +, - and multiplication by a number with a temporary matrix operand are
+// evaluated at once into its elements, so a + b * 2.0 - a * b or
+// (a * b) * 2.0 allocates only for the product. The lazy forms would hold a
+// reference to the temporary and evaluate into a new matrix
+template <typename T, typename R>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&lhs,
+                            const S21MatrixExpr<R> &rhs) {
+  lhs = lhs + rhs;
+  return std::move(lhs);
+}
+
+template <typename L, typename T>
+S21BasicMatrix<T> operator+(const S21MatrixExpr<L> &lhs,
+                            S21BasicMatrix<T> &&rhs) {
+  rhs = lhs + rhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&lhs, S21BasicMatrix<T> &&rhs) {
+  lhs = lhs + rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename R>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&lhs,
+                            const S21MatrixExpr<R> &rhs) {
+  lhs = lhs - rhs;
+  return std::move(lhs);
+}
+
+template <typename L, typename T>
+S21BasicMatrix<T> operator-(const S21MatrixExpr<L> &lhs,
+                            S21BasicMatrix<T> &&rhs) {
+  rhs = lhs - rhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&lhs, S21BasicMatrix<T> &&rhs) {
+  lhs = lhs - rhs;
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T> &&matrix,
+                            typename S21BasicMatrix<T>::value_type num) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(typename S21BasicMatrix<T>::value_type num,
+                            S21BasicMatrix<T> &&matrix) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+// Comparisons read both sides element by element, nothing is evaluated
+template <typename T, typename R>
+bool operator==(const S21BasicMatrix<T> &lhs, const S21MatrixExpr<R> &rhs) {
+  return S21ExprEqual(lhs, rhs);
+}
+
+template <typename L, typename R>
+bool operator==(const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs) {
+  return S21ExprEqual(lhs, rhs);
+}
+
 #endif  // S21_MATRIX_OOP_H
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef S21_MATRIX_VIEW_H
+#define S21_MATRIX_VIEW_H
+
+#include "s21_matrix_expr.h"
+
+// Read-only window into the elements of a matrix: the whole matrix, a block,
+// a range of rows or columns, a minor, or any of them transposed. Nothing is
+// copied, so a view must not outlive the matrix it was taken from or be used
+// after that matrix is resized. Members are defined in s21_matrix_oop.cc next
+// to the matrix operations they share
+template <typename T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T>> {
+ private:
+  // Element (i, j) of a block lives at data_[i * stride_ + j], or at
+  // data_[j * stride_ + i] if the view is transposed. A minor also shifts
+  // rows from skipRow_ and columns from skipCol_ on by one, plain blocks set
+  // them to rows_ and cols_ so that nothing is shifted
+  const T *data_;
+  int rows_, cols_, stride_;
+  int skipRow_, skipCol_;
+  bool transposed_;
+  void CheckIndices(int row, int col) const;
+  const T *Address(int row, int col) const {
+    row += row >= skipRow_;
+    col += col >= skipCol_;
+    return transposed_ ? data_ + col * stride_ + row
+                       : data_ + row * stride_ + col;
+  }
+
+ public:
+  using value_type = T;
+
+  S21BasicMatrixView(const T *data, int rows, int cols, int stride);
+
+  int GetRows() const;
+  int GetCols() const;
+  // Only a view without a removed row and column is a strided block, the
+  // elements of a minor have to be read with Coeff() or operator(). The
+  // storage of a transposed block is its transpose
+  bool IsBlock() const;
+  bool IsTransposed() const;
+  const T *GetData() const;
+  int GetStride() const;
+
+  // Views of a block are views too, a view of a minor cannot be narrowed
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView RowRange(int first, int count) const;
+  S21BasicMatrixView ColRange(int first, int count) const;
+  S21BasicMatrixView Minor(int row, int col) const;
+  // Lazy transpose, products, sums and comparisons read it in place
+  S21BasicMatrixView Transposed() const;
+
+  // Read-only operations, the same as the ones of S21BasicMatrix
+  bool EqMatrix(const S21BasicMatrixView &other) const;
+  S21BasicMatrix<T> Transpose() const;
+  T Determinant() const;
+
+  const T &operator()(int row, int col) const;
+  T Coeff(int row, int col) const { return *Address(row, col); }
+  // Whether the view is transposed and starts inside [begin, end), so that
+  // writing that range while reading the view would change its elements
+  bool ReadsTransposed(const T *begin, const T *end) const {
+    return transposed_ && data_ >= begin && data_ < end;
+  }
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+using S21MatrixViewF = S21BasicMatrixView<float>;
+using S21MatrixViewLD = S21BasicMatrixView<long double>;
+
+extern template class S21BasicMatrixView<float>;
+extern template class S21BasicMatrixView<double>;
+extern template class S21BasicMatrixView<long double>;
+
+#endif  // S21_MATRIX_VIEW_H
@@ -0,0 +1,511 @@
+#include "s21_packed_matrix.h"
+
+#include "s21_kernels.h"
+#include "s21_scratch_arena.h"
+
+// Rows of the products below are computed this many at a time: the packed
+// elements of a block of rows are unpacked into a dense panel in scratch
+// memory and the blocked matrix product adds it times the other operand
+// straight into those rows of the result
+static constexpr int kPackedBlock = 128;
+
+// Offset of row i of a packed lower triangle, in size_t since i * (i + 1)
+// overflows int from i = 46341 on
+static size_t LowerRowStart(int row) {
+  return static_cast<size_t>(row) * (row + 1) / 2;
+}
+
+template <typename T>
+S21BasicSymmetricMatrix<T>::S21BasicSymmetricMatrix(int size) : size_(size) {
+  if (size < 1) {
+    throw std::invalid_argument(
+        "There should be more than 1 row and/or column.");
+  }
+  data_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0);
+}
+
+template <typename T>
+S21BasicSymmetricMatrix<T>::S21BasicSymmetricMatrix(
+    const S21BasicMatrixView<T> &dense)
+    : S21BasicSymmetricMatrix(dense.GetRows()) {
+  if (dense.GetRows() != dense.GetCols())
+    throw std::invalid_argument("Matrix must be square.");
+  T *dst = data_.data();
+  for (int i = 0; i != size_; ++i) {
+    for (int j = 0; j <= i; ++j) *dst++ = dense.Coeff(i, j);
+  }
+}
+
+// Block of rows [first, first + rows) of the lower triangle is
+// A(:, first..)^T * A(:, 0..first + rows), the columns past the block are
+// never computed
+template <typename T>
+S21BasicSymmetricMatrix<T> S21BasicSymmetricMatrix<T>::Gram(
+    const S21BasicMatrixView<T> &a) {
+  if (!a.IsBlock() || a.IsTransposed()) return Gram(S21BasicMatrix<T>(a));
+  S21BasicSymmetricMatrix result(a.GetCols());
+  for (int first = 0; first < result.size_; first += kPackedBlock) {
+    const int rows = std::min(kPackedBlock, result.size_ - first);
+    S21ScratchScope scope;
+    S21BasicMatrix<T> block = S21BasicMatrix<T>::Scratch(rows, first + rows);
+    S21BasicMatrix<T>::Gemm(1, a.ColRange(first, rows), true,
+                            a.ColRange(0, first + rows), false, 0, block);
+    for (int i = 0; i != rows; ++i) {
+      const int row = first + i;
+      const T *src = block.matrix_ + i * block.stride_;
+      std::copy(src, src + row + 1, result.data_.data() + LowerRowStart(row));
+    }
+  }
+  return result;
+}
+
+template <typename T>
+int S21BasicSymmetricMatrix<T>::GetSize() const { return size_; }
+
+template <typename T>
+const T *S21BasicSymmetricMatrix<T>::GetData() const { return data_.data(); }
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSymmetricMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(size_, size_);
+  const T *src = data_.data();
+  for (int i = 0; i != size_; ++i) {
+    for (int j = 0; j <= i; ++j, ++src) {
+      result.matrix_[i * result.stride_ + j] = *src;
+      result.matrix_[j * result.stride_ + i] = *src;
+    }
+  }
+  return result;
+}
+
+template <typename T>
+bool S21BasicSymmetricMatrix<T>::EqMatrix(
+    const S21BasicSymmetricMatrix &other) const {
+  return size_ == other.size_ &&
+         std::equal(data_.begin(), data_.end(), other.data_.begin(),
+                    [](T a, T b) {
+                      return std::abs(a - b) < S21Tolerance<T>::kValue;
+                    });
+}
+
+template <typename T>
+void S21BasicSymmetricMatrix<T>::SumMatrix(
+    const S21BasicSymmetricMatrix &other) {
+  try {
+    if (size_ != other.size_)
+      throw std::invalid_argument("The sizes of matrices must match.");
+    S21TypedKernels<T>::Add(static_cast<int>(data_.size()),
+                            other.data_.data(), data_.data());
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+template <typename T>
+void S21BasicSymmetricMatrix<T>::SubMatrix(
+    const S21BasicSymmetricMatrix &other) {
+  try {
+    if (size_ != other.size_)
+      throw std::invalid_argument("The sizes of matrices must match.");
+    S21TypedKernels<T>::Sub(static_cast<int>(data_.size()),
+                            other.data_.data(), data_.data());
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+template <typename T>
+void S21BasicSymmetricMatrix<T>::MulNumber(const T num) {
+  S21TypedKernels<T>::Scale(static_cast<int>(data_.size()), num,
+                            data_.data());
+}
+
+// Full rows of a block are gathered from the lower triangle, row i of it
+// and column i below the diagonal
+template <typename T>
+S21BasicMatrix<T> S21BasicSymmetricMatrix<T>::MulDense(
+    const S21BasicMatrixView<T> &dense) const {
+  S21BasicMatrix<T> result = S21BasicMatrix<T>();
+  try {
+    if (size_ != dense.GetRows())
+      throw std::invalid_argument("Wrong matrices sizes for multiplication.");
+    if (!dense.IsBlock()) return MulDense(S21BasicMatrix<T>(dense));
+    result = S21BasicMatrix<T>(size_, dense.GetCols());
+    for (int first = 0; first < size_; first += kPackedBlock) {
+      const int rows = std::min(kPackedBlock, size_ - first);
+      S21ScratchScope scope;
+      S21BasicMatrix<T> panel = S21BasicMatrix<T>::Scratch(rows, size_);
+      for (int i = 0; i != rows; ++i) {
+        const int row = first + i;
+        T *dst = panel.matrix_ + i * panel.stride_;
+        const T *src = data_.data() + LowerRowStart(row);
+        std::copy(src, src + row + 1, dst);
+        for (int j = row + 1; j != size_; ++j) {
+          dst[j] = data_[LowerRowStart(j) + row];
+        }
+      }
+      S21BasicMatrix<T>::GemmAccumulate(
+          1, panel, dense, result.matrix_ + first * result.stride_,
+          result.stride_);
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+    result.DeleteMatrix();
+  }
+  return result;
+}
+
+template <typename T>
+bool S21BasicSymmetricMatrix<T>::operator==(
+    const S21BasicSymmetricMatrix &other) const {
+  return EqMatrix(other);
+}
+
+template <typename T>
+S21BasicSymmetricMatrix<T> &S21BasicSymmetricMatrix<T>::operator+=(
+    const S21BasicSymmetricMatrix &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSymmetricMatrix<T> &S21BasicSymmetricMatrix<T>::operator-=(
+    const S21BasicSymmetricMatrix &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSymmetricMatrix<T> &S21BasicSymmetricMatrix<T>::operator*=(
+    const T num) {
+  MulNumber(num);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSymmetricMatrix<T>::operator*(
+    const S21BasicMatrixView<T> &dense) const {
+  return MulDense(dense);
+}
+
+template <typename T>
+T &S21BasicSymmetricMatrix<T>::operator()(int row, int col) {
+  CheckIndices(row, col);
+  if (row < col) std::swap(row, col);
+  return data_[LowerRowStart(row) + col];
+}
+
+template <typename T>
+const T &S21BasicSymmetricMatrix<T>::operator()(int row, int col) const {
+  CheckIndices(row, col);
+  if (row < col) std::swap(row, col);
+  return data_[LowerRowStart(row) + col];
+}
+
+template <typename T>
+void S21BasicSymmetricMatrix<T>::CheckIndices(int row, int col) const {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_)
+    throw std::invalid_argument("The element is outside the matrix.");
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T>::S21BasicTriangularMatrix(int size,
+                                                      S21Triangle triangle)
+    : size_(size), triangle_(triangle) {
+  if (size < 1) {
+    throw std::invalid_argument(
+        "There should be more than 1 row and/or column.");
+  }
+  data_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0);
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T>::S21BasicTriangularMatrix(
+    const S21BasicMatrixView<T> &dense, S21Triangle triangle)
+    : S21BasicTriangularMatrix(dense.GetRows(), triangle) {
+  if (dense.GetRows() != dense.GetCols())
+    throw std::invalid_argument("Matrix must be square.");
+  T *dst = data_.data();
+  for (int i = 0; i != size_; ++i) {
+    for (int j = FirstCol(i); j <= LastCol(i); ++j) *dst++ = dense.Coeff(i, j);
+  }
+}
+
+template <typename T>
+int S21BasicTriangularMatrix<T>::GetSize() const { return size_; }
+
+template <typename T>
+S21Triangle S21BasicTriangularMatrix<T>::GetTriangle() const {
+  return triangle_;
+}
+
+template <typename T>
+const T *S21BasicTriangularMatrix<T>::GetData() const { return data_.data(); }
+
+template <typename T>
+S21BasicMatrix<T> S21BasicTriangularMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(size_, size_);
+  for (int i = 0; i != size_; ++i) {
+    std::copy(data_.begin() + RowStart(i),
+              data_.begin() + RowStart(i) + LastCol(i) - FirstCol(i) + 1,
+              result.matrix_ + i * result.stride_ + FirstCol(i));
+  }
+  return result;
+}
+
+template <typename T>
+bool S21BasicTriangularMatrix<T>::EqMatrix(
+    const S21BasicTriangularMatrix &other) const {
+  if (size_ != other.size_) return false;
+  if (triangle_ != other.triangle_) return ToDense() == other.ToDense();
+  return std::equal(data_.begin(), data_.end(), other.data_.begin(),
+                    [](T a, T b) {
+                      return std::abs(a - b) < S21Tolerance<T>::kValue;
+                    });
+}
+
+template <typename T>
+void S21BasicTriangularMatrix<T>::SumMatrix(
+    const S21BasicTriangularMatrix &other) {
+  try {
+    if (Mismatch(other))
+      throw std::invalid_argument(
+          "The sizes and triangles of matrices must match.");
+    S21TypedKernels<T>::Add(static_cast<int>(data_.size()),
+                            other.data_.data(), data_.data());
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+template <typename T>
+void S21BasicTriangularMatrix<T>::SubMatrix(
+    const S21BasicTriangularMatrix &other) {
+  try {
+    if (Mismatch(other))
+      throw std::invalid_argument(
+          "The sizes and triangles of matrices must match.");
+    S21TypedKernels<T>::Sub(static_cast<int>(data_.size()),
+                            other.data_.data(), data_.data());
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+template <typename T>
+void S21BasicTriangularMatrix<T>::MulNumber(const T num) {
+  S21TypedKernels<T>::Scale(static_cast<int>(data_.size()), num,
+                            data_.data());
+}
+
+// Row i of the product adds A(i, k) times row k of the other matrix for
+// every k of row i. That row lies inside row i of the result, so both are
+// packed and the update is a single axpy
+template <typename T>
+void S21BasicTriangularMatrix<T>::MulMatrix(
+    const S21BasicTriangularMatrix &other) {
+  try {
+    if (Mismatch(other))
+      throw std::invalid_argument(
+          "The sizes and triangles of matrices must match.");
+    S21BasicTriangularMatrix result(size_, triangle_);
+    for (int i = 0; i != size_; ++i) {
+      T *dst = result.data_.data() + RowStart(i);
+      for (int k = FirstCol(i); k <= LastCol(i); ++k) {
+        const T a = data_[RowStart(i) + k - FirstCol(i)];
+        S21TypedKernels<T>::Axpy(LastCol(k) - FirstCol(k) + 1, a,
+                                 other.data_.data() + RowStart(k),
+                                 dst + FirstCol(k) - FirstCol(i));
+      }
+    }
+    data_.swap(result.data_);
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+// A block of rows only multiplies the columns its triangle covers, so about
+// half of the general product is skipped
+template <typename T>
+S21BasicMatrix<T> S21BasicTriangularMatrix<T>::MulDense(
+    const S21BasicMatrixView<T> &dense) const {
+  S21BasicMatrix<T> result = S21BasicMatrix<T>();
+  try {
+    if (size_ != dense.GetRows())
+      throw std::invalid_argument("Wrong matrices sizes for multiplication.");
+    if (!dense.IsBlock() || dense.IsTransposed())
+      return MulDense(S21BasicMatrix<T>(dense));
+    result = S21BasicMatrix<T>(size_, dense.GetCols());
+    for (int first = 0; first < size_; first += kPackedBlock) {
+      const int rows = std::min(kPackedBlock, size_ - first);
+      const int begin = FirstCol(first), end = LastCol(first + rows - 1) + 1;
+      S21ScratchScope scope;
+      S21BasicMatrix<T> panel =
+          S21BasicMatrix<T>::Scratch(rows, end - begin);
+      for (int i = 0; i != rows; ++i) {
+        const int row = first + i;
+        const T *src = data_.data() + RowStart(row);
+        std::copy(src, src + LastCol(row) - FirstCol(row) + 1,
+                  panel.matrix_ + i * panel.stride_ + FirstCol(row) - begin);
+      }
+      S21BasicMatrix<T>::GemmAccumulate(
+          1, panel, dense.RowRange(begin, end - begin),
+          result.matrix_ + first * result.stride_, result.stride_);
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+    result.DeleteMatrix();
+  }
+  return result;
+}
+
+// Rows are solved from the end of the triangle with one element, the first
+// row of a lower matrix or the last row of an upper one
+template <typename T>
+S21BasicMatrix<T> S21BasicTriangularMatrix<T>::Solve(
+    const S21BasicMatrixView<T> &b) const {
+  S21BasicMatrix<T> x = S21BasicMatrix<T>();
+  try {
+    if (b.GetRows() != size_)
+      throw std::invalid_argument("Wrong matrices sizes for solving.");
+    // The product of the diagonal underflows for large matrices, so every
+    // element the substitution divides by is checked instead, with the
+    // tolerance of the dense LU
+    for (int i = 0; i != size_; ++i) {
+      if (std::abs(data_[RowStart(i) + i - FirstCol(i)]) <=
+          S21Tolerance<T>::kValue)
+        throw std::invalid_argument(
+            "Cannot solve a system with 0 determinant.");
+    }
+    x = b;
+    const int m = x.cols_, xs = x.stride_;
+    const bool lower = triangle_ == S21Triangle::kLower;
+    for (int step = 0; step != size_; ++step) {
+      const int i = lower ? step : size_ - 1 - step;
+      const T *row = data_.data() + RowStart(i) - FirstCol(i);
+      T *rowI = x.matrix_ + i * xs;
+      for (int k = FirstCol(i); k <= LastCol(i); ++k) {
+        if (k != i) {
+          S21TypedKernels<T>::Axpy(m, -row[k], x.matrix_ + k * xs, rowI);
+        }
+      }
+      S21TypedKernels<T>::Scale(m, 1 / row[i], rowI);
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+    x.DeleteMatrix();
+  }
+  return x;
+}
+
+template <typename T>
+T S21BasicTriangularMatrix<T>::Determinant() const {
+  T det = 1;
+  for (int i = 0; i != size_; ++i) det *= data_[RowStart(i) + i - FirstCol(i)];
+  return det;
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T> S21BasicTriangularMatrix<T>::Transpose() const {
+  S21BasicTriangularMatrix result(size_, triangle_ == S21Triangle::kLower
+                                             ? S21Triangle::kUpper
+                                             : S21Triangle::kLower);
+  const T *src = data_.data();
+  for (int i = 0; i != size_; ++i) {
+    for (int j = FirstCol(i); j <= LastCol(i); ++j, ++src) {
+      result.data_[result.RowStart(j) + i - result.FirstCol(j)] = *src;
+    }
+  }
+  return result;
+}
+
+template <typename T>
+bool S21BasicTriangularMatrix<T>::operator==(
+    const S21BasicTriangularMatrix &other) const {
+  return EqMatrix(other);
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T> &S21BasicTriangularMatrix<T>::operator+=(
+    const S21BasicTriangularMatrix &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T> &S21BasicTriangularMatrix<T>::operator-=(
+    const S21BasicTriangularMatrix &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T> &S21BasicTriangularMatrix<T>::operator*=(
+    const S21BasicTriangularMatrix &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicTriangularMatrix<T> &S21BasicTriangularMatrix<T>::operator*=(
+    const T num) {
+  MulNumber(num);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicTriangularMatrix<T>::operator*(
+    const S21BasicMatrixView<T> &dense) const {
+  return MulDense(dense);
+}
+
+template <typename T>
+T &S21BasicTriangularMatrix<T>::operator()(int row, int col) {
+  CheckIndices(row, col);
+  if (col < FirstCol(row) || col > LastCol(row))
+    throw std::invalid_argument("The element is outside the triangle.");
+  return data_[RowStart(row) + col - FirstCol(row)];
+}
+
+template <typename T>
+T S21BasicTriangularMatrix<T>::operator()(int row, int col) const {
+  CheckIndices(row, col);
+  if (col < FirstCol(row) || col > LastCol(row)) return 0;
+  return data_[RowStart(row) + col - FirstCol(row)];
+}
+
+template <typename T>
+size_t S21BasicTriangularMatrix<T>::RowStart(int row) const {
+  return triangle_ == S21Triangle::kLower
+             ? LowerRowStart(row)
+             : static_cast<size_t>(row) * size_ - LowerRowStart(row - 1);
+}
+
+template <typename T>
+int S21BasicTriangularMatrix<T>::FirstCol(int row) const {
+  return triangle_ == S21Triangle::kLower ? 0 : row;
+}
+
+template <typename T>
+int S21BasicTriangularMatrix<T>::LastCol(int row) const {
+  return triangle_ == S21Triangle::kLower ? row : size_ - 1;
+}
+
+template <typename T>
+void S21BasicTriangularMatrix<T>::CheckIndices(int row, int col) const {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_)
+    throw std::invalid_argument("The element is outside the matrix.");
+}
+
+template <typename T>
+bool S21BasicTriangularMatrix<T>::Mismatch(
+    const S21BasicTriangularMatrix &other) const {
+  return size_ != other.size_ || triangle_ != other.triangle_;
+}
+
+template class S21BasicSymmetricMatrix<float>;
+template class S21BasicSymmetricMatrix<double>;
+template class S21BasicSymmetricMatrix<long double>;
+template class S21BasicTriangularMatrix<float>;
+template class S21BasicTriangularMatrix<double>;
+template class S21BasicTriangularMatrix<long double>;
@@ -0,0 +1,125 @@
+#ifndef S21_PACKED_MATRIX_H
+#define S21_PACKED_MATRIX_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Triangle kept by a packed matrix
+enum class S21Triangle { kLower, kUpper };
+
+// Symmetric n x n matrix that stores its lower triangle only, n(n+1)/2
+// elements packed row by row. Members are defined in s21_packed_matrix.cc
+// and instantiated there for float, double and long double
+template <typename T>
+class S21BasicSymmetricMatrix {
+ private:
+  // Element (i, j) with j <= i lives at data_[i * (i + 1) / 2 + j]
+  int size_;
+  std::vector<T> data_;
+  void CheckIndices(int row, int col) const;
+
+ public:
+  using value_type = T;
+
+  // A new matrix is filled with zeros. A dense matrix must be square, only
+  // its lower triangle is read
+  explicit S21BasicSymmetricMatrix(int size = 1);
+  explicit S21BasicSymmetricMatrix(const S21BasicMatrixView<T> &dense);
+  // A^T * A computed on the lower triangle only, half the multiply-adds of
+  // the general product
+  static S21BasicSymmetricMatrix Gram(const S21BasicMatrixView<T> &a);
+
+  int GetSize() const;
+  const T *GetData() const;
+  S21BasicMatrix<T> ToDense() const;
+
+  // Operations
+  bool EqMatrix(const S21BasicSymmetricMatrix &other) const;
+  void SumMatrix(const S21BasicSymmetricMatrix &other);
+  void SubMatrix(const S21BasicSymmetricMatrix &other);
+  void MulNumber(const T num);
+  // Symmetric times dense on the blocked matrix product
+  S21BasicMatrix<T> MulDense(const S21BasicMatrixView<T> &dense) const;
+
+  // Operators
+  bool operator==(const S21BasicSymmetricMatrix &other) const;
+  S21BasicSymmetricMatrix &operator+=(const S21BasicSymmetricMatrix &other);
+  S21BasicSymmetricMatrix &operator-=(const S21BasicSymmetricMatrix &other);
+  S21BasicSymmetricMatrix &operator*=(const T num);
+  S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &dense) const;
+  // (i, j) and (j, i) are the same element
+  T &operator()(int row, int col);
+  const T &operator()(int row, int col) const;
+};
+
+// Lower or upper triangular n x n matrix that stores n(n+1)/2 elements of
+// its triangle packed row by row, the other elements are zero
+template <typename T>
+class S21BasicTriangularMatrix {
+ private:
+  // Row i of a lower matrix holds columns 0..i and starts at i * (i + 1) / 2,
+  // row i of an upper one holds columns i..n-1 and starts at
+  // i * n - i * (i - 1) / 2
+  int size_;
+  S21Triangle triangle_;
+  std::vector<T> data_;
+  size_t RowStart(int row) const;
+  int FirstCol(int row) const;
+  int LastCol(int row) const;
+  void CheckIndices(int row, int col) const;
+  bool Mismatch(const S21BasicTriangularMatrix &other) const;
+
+ public:
+  using value_type = T;
+
+  explicit S21BasicTriangularMatrix(int size = 1,
+                                    S21Triangle triangle = S21Triangle::kLower);
+  // A dense matrix must be square, the elements outside the triangle are
+  // ignored
+  S21BasicTriangularMatrix(const S21BasicMatrixView<T> &dense,
+                           S21Triangle triangle);
+
+  int GetSize() const;
+  S21Triangle GetTriangle() const;
+  const T *GetData() const;
+  S21BasicMatrix<T> ToDense() const;
+
+  // Operations, both operands must keep the same triangle
+  bool EqMatrix(const S21BasicTriangularMatrix &other) const;
+  void SumMatrix(const S21BasicTriangularMatrix &other);
+  void SubMatrix(const S21BasicTriangularMatrix &other);
+  void MulNumber(const T num);
+  // The product of two lower or two upper matrices keeps their triangle
+  void MulMatrix(const S21BasicTriangularMatrix &other);
+  // Triangular times dense, only the stored triangle is multiplied
+  S21BasicMatrix<T> MulDense(const S21BasicMatrixView<T> &dense) const;
+  // Solves A * X = B by forward or back substitution, O(n^2) per column
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T> &b) const;
+  // Product of the diagonal
+  T Determinant() const;
+  S21BasicTriangularMatrix Transpose() const;
+
+  // Operators
+  bool operator==(const S21BasicTriangularMatrix &other) const;
+  S21BasicTriangularMatrix &operator+=(const S21BasicTriangularMatrix &other);
+  S21BasicTriangularMatrix &operator-=(const S21BasicTriangularMatrix &other);
+  S21BasicTriangularMatrix &operator*=(const S21BasicTriangularMatrix &other);
+  S21BasicTriangularMatrix &operator*=(const T num);
+  S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &dense) const;
+  // Only elements of the triangle can be written, the others read as zero
+  T &operator()(int row, int col);
+  T operator()(int row, int col) const;
+};
+
+using S21SymmetricMatrix = S21BasicSymmetricMatrix<double>;
+using S21TriangularMatrix = S21BasicTriangularMatrix<double>;
+
+extern template class S21BasicSymmetricMatrix<float>;
+extern template class S21BasicSymmetricMatrix<double>;
+extern template class S21BasicSymmetricMatrix<long double>;
+extern template class S21BasicTriangularMatrix<float>;
+extern template class S21BasicTriangularMatrix<double>;
+extern template class S21BasicTriangularMatrix<long double>;
+
+#endif  // S21_PACKED_MATRIX_H
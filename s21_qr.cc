@@ -0,0 +1,230 @@
+#include "s21_qr.h"
+
+#include "s21_kernels.h"
+#include "s21_scratch_arena.h"
+
+// Columns whose reflectors are applied to the rest of the matrix together.
+// Inside such a panel the columns are halved until kQRLeaf of them are
+// left, those are reflected one by one
+static constexpr int kQRBlock = 32, kQRLeaf = 8;
+
+template <typename T>
+S21BasicQR<T>::S21BasicQR(const S21BasicMatrixView<T> &matrix)
+    : qr_(matrix), tau_(matrix.GetCols()) {
+  if (matrix.GetRows() < matrix.GetCols()) {
+    throw std::invalid_argument(
+        "Matrix must have at least as many rows as columns.");
+  }
+  Factorize();
+}
+
+template <typename T>
+int S21BasicQR<T>::GetRows() const { return qr_.rows_; }
+
+template <typename T>
+int S21BasicQR<T>::GetCols() const { return qr_.cols_; }
+
+template <typename T>
+bool S21BasicQR<T>::IsFullRank() const {
+  for (int k = 0; k != qr_.cols_; ++k) {
+    if (std::abs(qr_.matrix_[k * qr_.stride_ + k]) <= S21Tolerance<T>::kValue)
+      return false;
+  }
+  return true;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::GetR() const {
+  const int n = qr_.cols_;
+  S21BasicMatrix<T> r(n, n);
+  for (int i = 0; i != n; ++i) {
+    std::copy(qr_.matrix_ + i * qr_.stride_ + i,
+              qr_.matrix_ + i * qr_.stride_ + n, r.matrix_ + i * r.stride_ + i);
+  }
+  return r;
+}
+
+// Applies Q^T to B panel by panel, then solves R * X = (Q^T * B)(0..n) by
+// back substitution
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::Solve(const S21BasicMatrixView<T> &b) const {
+  const int m = qr_.rows_, n = qr_.cols_, qs = qr_.stride_;
+  S21BasicMatrix<T> x = S21BasicMatrix<T>();
+  try {
+    if (b.GetRows() != m)
+      throw std::invalid_argument("Wrong matrices sizes for solving.");
+    if (!IsFullRank())
+      throw std::invalid_argument("Matrix must have full column rank.");
+    S21BasicMatrix<T> y(b);
+    const int p = y.cols_, ys = y.stride_;
+    for (int panel = 0; panel * kQRBlock < n; ++panel) {
+      S21ScratchScope scope;
+      const int first = panel * kQRBlock;
+      ApplyBlock(Vectors(first, std::min(kQRBlock, n - first)),
+                 panels_[panel], y, first, 0, p);
+    }
+    x = S21BasicMatrix<T>(n, p);
+    const int xs = x.stride_;
+    for (int i = n - 1; i >= 0; --i) {
+      T *rowI = x.matrix_ + i * xs;
+      std::copy(y.matrix_ + i * ys, y.matrix_ + i * ys + p, rowI);
+      for (int k = i + 1; k != n; ++k) {
+        S21TypedKernels<T>::Axpy(p, -qr_.matrix_[i * qs + k],
+                                 x.matrix_ + k * xs, rowI);
+      }
+      S21TypedKernels<T>::Scale(p, 1 / qr_.matrix_[i * qs + i], rowI);
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+    x.DeleteMatrix();
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::LeastSquares(const S21BasicMatrixView<T> &a,
+                                              const S21BasicMatrixView<T> &b) {
+  return S21BasicQR(a).Solve(b);
+}
+
+template <typename T>
+void S21BasicQR<T>::Factorize() {
+  const int n = qr_.cols_;
+  panels_.reserve((n + kQRBlock - 1) / kQRBlock);
+  for (int first = 0; first < n; first += kQRBlock) {
+    S21ScratchScope scope;
+    const int cols = std::min(kQRBlock, n - first);
+    FactorizeRange(first, cols);
+    const S21BasicMatrix<T> v = Vectors(first, cols);
+    panels_.emplace_back(cols, cols);
+    BlockFactor(v, first, panels_.back());
+    if (first + cols != n) {
+      ApplyBlock(v, panels_.back(), qr_, first, first + cols,
+                 n - first - cols);
+    }
+  }
+}
+
+// Recursive panel factorization: the left half is factorized, its
+// reflectors update the right half with matrix products, then the right
+// half is factorized. Only the leaves work column by column
+template <typename T>
+void S21BasicQR<T>::FactorizeRange(int first, int cols) {
+  if (cols <= kQRLeaf) {
+    for (int k = first; k != first + cols; ++k) Reflect(k, first + cols);
+    return;
+  }
+  const int half = cols / 2;
+  FactorizeRange(first, half);
+  S21ScratchScope scope;
+  const S21BasicMatrix<T> v = Vectors(first, half);
+  S21BasicMatrix<T> s = S21BasicMatrix<T>::Scratch(half, half);
+  BlockFactor(v, first, s);
+  ApplyBlock(v, s, qr_, first, first + half, cols - half);
+  FactorizeRange(first + half, cols - half);
+}
+
+// Householder reflector of column k that zeroes it below the diagonal,
+// applied to columns k + 1..lastCol
+template <typename T>
+void S21BasicQR<T>::Reflect(int k, int lastCol) {
+  const int m = qr_.rows_, qs = qr_.stride_;
+  T *a = qr_.matrix_;
+  T below = 0;
+  for (int i = k + 1; i != m; ++i) below += a[i * qs + k] * a[i * qs + k];
+  // A column that is already zero below the diagonal needs no reflection
+  if (below == 0) {
+    tau_[k] = 0;
+    return;
+  }
+  const T alpha = a[k * qs + k];
+  const T norm = std::sqrt(alpha * alpha + below);
+  const T beta = alpha > 0 ? -norm : norm;
+  const T scale = 1 / (alpha - beta);
+  const T tau = (beta - alpha) / beta;
+  tau_[k] = tau;
+  a[k * qs + k] = beta;
+  // v = (1, A(k + 1.., k) * scale), w = v^T * A(k.., k + 1..lastCol) and
+  // A -= tau * v * w. The column is scaled during the last pass
+  const int cols = lastCol - k - 1;
+  T *rowK = a + k * qs + k + 1;
+  S21ScratchScope scope;
+  T *w = S21ScratchArena::Local().Allocate<T>(std::max(cols, 0));
+  std::copy(rowK, rowK + std::max(cols, 0), w);
+  for (int i = k + 1; i != m && cols > 0; ++i) {
+    const T v = a[i * qs + k] * scale;
+    const T *rowI = a + i * qs + k + 1;
+    for (int j = 0; j != cols; ++j) w[j] += v * rowI[j];
+  }
+  for (int j = 0; j < cols; ++j) rowK[j] -= tau * w[j];
+  for (int i = k + 1; i != m; ++i) {
+    T *rowI = a + i * qs + k;
+    rowI[0] *= scale;
+    const T v = tau * rowI[0];
+    for (int j = 0; j < cols; ++j) rowI[j + 1] -= v * w[j];
+  }
+}
+
+// Householder vectors of columns [first, first + cols) with their leading
+// 1 and the zeros above it, rows first..m, in scratch memory
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::Vectors(int first, int cols) const {
+  const int rows = qr_.rows_ - first;
+  S21BasicMatrix<T> v = S21BasicMatrix<T>::Scratch(rows, cols);
+  for (int i = 0; i != rows; ++i) {
+    const T *src = qr_.matrix_ + (first + i) * qr_.stride_ + first;
+    T *dst = v.matrix_ + i * v.stride_;
+    std::copy(src, src + std::min(i, cols), dst);
+    if (i < cols) dst[i] = 1;
+  }
+  return v;
+}
+
+// Upper triangular S with H_first * ... * H_(first + cols - 1) =
+// I - V * S * V^T (compact WY form), column j of S is
+// -tau_j * S(0..j, 0..j) * V(:, 0..j)^T * v_j. s must be a zero cols x cols
+// matrix
+template <typename T>
+void S21BasicQR<T>::BlockFactor(const S21BasicMatrix<T> &v, int first,
+                                S21BasicMatrix<T> &s) const {
+  const int cols = v.cols_;
+  S21ScratchScope scope;
+  S21BasicMatrix<T> gram = S21BasicMatrix<T>::Scratch(cols, cols);
+  S21BasicMatrix<T>::Gemm(1, v, true, v, false, 0, gram);
+  for (int j = 0; j != cols; ++j) {
+    const T tau = tau_[first + j];
+    T *column = s.matrix_ + j;
+    for (int i = 0; i != j; ++i) {
+      const T *rowI = s.matrix_ + i * s.stride_;
+      T sum = 0;
+      for (int p = i; p != j; ++p) sum += rowI[p] * gram.matrix_[p * cols + j];
+      column[i * s.stride_] = -tau * sum;
+    }
+    column[j * s.stride_] = tau;
+  }
+}
+
+// C = (I - V * S * V^T)^T * C for the block C of target at (row, col) with
+// cols columns and the rows of V, as C - V * (S^T * (V^T * C)). The last
+// product has only V's width as inner size and goes straight to the kernel
+template <typename T>
+void S21BasicQR<T>::ApplyBlock(const S21BasicMatrix<T> &v,
+                               const S21BasicMatrix<T> &s,
+                               S21BasicMatrix<T> &target, int row, int col,
+                               int cols) {
+  const int rows = v.rows_, width = v.cols_;
+  S21ScratchScope scope;
+  S21BasicMatrix<T> w = S21BasicMatrix<T>::Scratch(width, cols);
+  S21BasicMatrix<T> sw = S21BasicMatrix<T>::Scratch(width, cols);
+  S21BasicMatrix<T>::Gemm(1, v, true, target.Block(row, col, rows, cols),
+                          false, 0, w);
+  S21BasicMatrix<T>::Gemm(-1, s, true, w, false, 0, sw);
+  S21TypedKernels<T>::Gemm(rows, cols, width, v.matrix_, v.stride_,
+                           sw.matrix_, sw.stride_,
+                           target.matrix_ + row * target.stride_ + col,
+                           target.stride_);
+}
+
+template class S21BasicQR<float>;
+template class S21BasicQR<double>;
+template class S21BasicQR<long double>;
@@ -0,0 +1,57 @@
+#ifndef S21_QR_H
+#define S21_QR_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Householder QR factorization A = Q * R of an m x n matrix with m >= n.
+// Reflectors are grouped into blocks that are applied at once by the
+// blocked matrix product, so tall matrices stream through the cache a few
+// times instead of once per column
+template <typename T>
+class S21BasicQR {
+ private:
+  // R on and above the diagonal, below it the Householder vectors v_k
+  // without their leading 1. Q = H_0 * ... * H_(n-1), H_k = I - tau_k v_k v_k^T
+  S21BasicMatrix<T> qr_;
+  std::vector<T> tau_;
+  // Upper triangular S of every panel of kQRBlock columns, the reflectors
+  // of the panel multiply to I - V * S * V^T
+  std::vector<S21BasicMatrix<T>> panels_;
+  void Factorize();
+  void FactorizeRange(int first, int cols);
+  void Reflect(int k, int lastCol);
+  // Temporaries of the factorization and of Solve() live in S21ScratchArena
+  S21BasicMatrix<T> Vectors(int first, int cols) const;
+  void BlockFactor(const S21BasicMatrix<T> &v, int first,
+                   S21BasicMatrix<T> &s) const;
+  static void ApplyBlock(const S21BasicMatrix<T> &v, const S21BasicMatrix<T> &s,
+                         S21BasicMatrix<T> &target, int row, int col,
+                         int cols);
+
+ public:
+  explicit S21BasicQR(const S21BasicMatrixView<T> &matrix);
+
+  int GetRows() const;
+  int GetCols() const;
+  // False if a diagonal element of R is 0 within the tolerance
+  bool IsFullRank() const;
+  // The n x n upper triangular factor
+  S21BasicMatrix<T> GetR() const;
+
+  // Least-squares solution of A * X = B for every column of B: X minimizes
+  // the norm of A * X - B, and for a square A it solves the system
+  S21BasicMatrix<T> Solve(const S21BasicMatrixView<T> &b) const;
+  // S21BasicQR(a).Solve(b), without forming the normal equations A^T * A
+  static S21BasicMatrix<T> LeastSquares(const S21BasicMatrixView<T> &a,
+                                        const S21BasicMatrixView<T> &b);
+};
+
+using S21QR = S21BasicQR<double>;
+
+extern template class S21BasicQR<float>;
+extern template class S21BasicQR<double>;
+extern template class S21BasicQR<long double>;
+
+#endif  // S21_QR_H
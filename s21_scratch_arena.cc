@@ -0,0 +1,87 @@
+#include "s21_scratch_arena.h"
+
+#include <algorithm>
+#include <new>
+
+// Smallest chunk the arena asks for, enough for the temporaries of a
+// 90x90 double determinant without growing
+static constexpr std::size_t kMinChunk = std::size_t(1) << 16;
+
+S21ScratchArena::S21ScratchArena()
+    : chunk_(nullptr), top_(0), used_(0), peak_(0), depth_(0), grew_(false) {}
+
+S21ScratchArena::~S21ScratchArena() { FreeChunks(nullptr); }
+
+S21ScratchArena &S21ScratchArena::Local() {
+  static thread_local S21ScratchArena arena;
+  return arena;
+}
+
+void *S21ScratchArena::AllocateBytes(std::size_t bytes) {
+  bytes = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  if (!chunk_ || top_ + bytes > chunk_->size) {
+    const std::size_t size = chunk_ ? 2 * chunk_->size : kMinChunk;
+    AddChunk(std::max(size, kAlignment + bytes));
+  }
+  void *block = reinterpret_cast<char *>(chunk_) + top_;
+  top_ += bytes;
+  used_ += bytes;
+  peak_ = std::max(peak_, used_);
+  return block;
+}
+
+std::size_t S21ScratchArena::GetCapacity() const {
+  std::size_t capacity = 0;
+  for (const Chunk *chunk = chunk_; chunk; chunk = chunk->previous) {
+    capacity += chunk->size;
+  }
+  return capacity;
+}
+
+void S21ScratchArena::Release() {
+  if (depth_ == 0) FreeChunks(nullptr);
+}
+
+void S21ScratchArena::AddChunk(std::size_t bytes) {
+  Chunk *chunk = static_cast<Chunk *>(
+      ::operator new(bytes, std::align_val_t(kAlignment)));
+  chunk->previous = chunk_;
+  chunk->size = bytes;
+  chunk_ = chunk;
+  top_ = kAlignment;
+  grew_ = true;
+}
+
+// Frees the chunks newer than last
+void S21ScratchArena::FreeChunks(const Chunk *last) {
+  while (chunk_ != last) {
+    Chunk *previous = chunk_->previous;
+    ::operator delete(chunk_, std::align_val_t(kAlignment));
+    chunk_ = previous;
+  }
+  if (!chunk_) top_ = 0;
+}
+
+S21ScratchScope::S21ScratchScope()
+    : arena_(S21ScratchArena::Local()),
+      chunk_(arena_.chunk_),
+      top_(arena_.top_),
+      used_(arena_.used_) {
+  ++arena_.depth_;
+}
+
+// Chunks added inside the scope are freed. The outermost scope then replaces
+// the chunks by a single one that fits the whole operation
+S21ScratchScope::~S21ScratchScope() {
+  arena_.FreeChunks(chunk_);
+  arena_.top_ = top_;
+  arena_.used_ = used_;
+  if (--arena_.depth_ == 0) {
+    if (arena_.grew_) {
+      arena_.FreeChunks(nullptr);
+      arena_.AddChunk(S21ScratchArena::kAlignment + arena_.peak_);
+      arena_.grew_ = false;
+    }
+    arena_.peak_ = 0;
+  }
+}
@@ -0,0 +1,71 @@
+#ifndef S21_SCRATCH_ARENA_H
+#define S21_SCRATCH_ARENA_H
+
+#include <cstddef>
+
+// Bump allocator for the temporaries of one top-level operation, one per
+// thread. Memory is handed out in order and taken back all at once when the
+// S21ScratchScope opened before it ends. When the outermost scope of the
+// thread ends after the arena had to grow, its chunks are merged into one of
+// the peak size, so repeating the operation does not allocate
+class S21ScratchArena {
+  friend class S21ScratchScope;
+
+ public:
+  static constexpr std::size_t kAlignment = 64;
+
+  S21ScratchArena(const S21ScratchArena &) = delete;
+  S21ScratchArena &operator=(const S21ScratchArena &) = delete;
+  ~S21ScratchArena();
+
+  // Arena of the calling thread
+  static S21ScratchArena &Local();
+
+  // Uninitialized room for count elements aligned to kAlignment, valid until
+  // the innermost open scope ends. Must be called inside a scope
+  template <typename T>
+  T *Allocate(std::size_t count) {
+    return static_cast<T *>(AllocateBytes(count * sizeof(T)));
+  }
+  void *AllocateBytes(std::size_t bytes);
+
+  // Bytes of the chunks the arena holds
+  std::size_t GetCapacity() const;
+  // Frees every chunk, only outside of any scope
+  void Release();
+
+ private:
+  // Chunks start with this header and are linked from the newest one, the
+  // memory handed out starts kAlignment bytes in
+  struct Chunk {
+    Chunk *previous;
+    std::size_t size;
+  };
+  Chunk *chunk_;
+  // Bytes taken from the current chunk, header included
+  std::size_t top_;
+  // Bytes handed out during the current operation and their maximum
+  std::size_t used_, peak_;
+  int depth_;
+  bool grew_;
+  S21ScratchArena();
+  void AddChunk(std::size_t bytes);
+  void FreeChunks(const Chunk *last);
+};
+
+// Marks the arena of the calling thread and rewinds it to the mark when it
+// ends. Scopes nest, the memory of an inner scope is reused by the next one
+class S21ScratchScope {
+ private:
+  S21ScratchArena &arena_;
+  S21ScratchArena::Chunk *chunk_;
+  std::size_t top_, used_;
+
+ public:
+  S21ScratchScope();
+  S21ScratchScope(const S21ScratchScope &) = delete;
+  S21ScratchScope &operator=(const S21ScratchScope &) = delete;
+  ~S21ScratchScope();
+};
+
+#endif  // S21_SCRATCH_ARENA_H
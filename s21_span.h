@@ -0,0 +1,43 @@
+#ifndef S21_SPAN_H
+#define S21_SPAN_H
+
+#include <stdexcept>
+#include <type_traits>
+
+// Contiguous run of elements that it does not own, the part of C++20
+// std::span the library needs. It is valid as long as the storage it was
+// taken from. S21Span<const T> only reads, S21Span<T> converts to it.
+// Indices are checked when S21_MATRIX_DEBUG is defined
+template <typename T>
+class S21Span {
+ private:
+  T *data_;
+  int size_;
+
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using iterator = T *;
+
+  S21Span() : data_(nullptr), size_(0) {}
+  S21Span(T *data, int size) : data_(data), size_(size) {}
+  template <typename U,
+            typename = std::enable_if_t<std::is_same<const U, T>::value>>
+  S21Span(const S21Span<U> &other) : data_(other.data()), size_(other.size()) {}
+
+  T *data() const { return data_; }
+  int size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  iterator begin() const { return data_; }
+  iterator end() const { return data_ + size_; }
+
+  T &operator[](int index) const {
+#ifdef S21_MATRIX_DEBUG
+    if (index < 0 || index >= size_)
+      throw std::invalid_argument("Index is outside the span.");
+#endif
+    return data_[index];
+  }
+};
+
+#endif  // S21_SPAN_H
@@ -0,0 +1,484 @@
+#include "s21_sparse_matrix.h"
+
+#include "s21_kernels.h"
+#include "s21_thread_pool.h"
+
+// Multiply-adds below which a sparse times dense product is not worth
+// handing to the thread pool, also the least work given to one chunk
+static constexpr long long kSparseParallelWork = 1 << 16;
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix()
+    : rows_(1), cols_(1), format_(S21SparseFormat::kCSR), starts_(2) {}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols,
+                                              S21SparseFormat format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows < 1 || cols < 1) {
+    throw std::invalid_argument(
+        "There should be more than 1 row and/or column.");
+  }
+  starts_.assign(Outer() + 1, 0);
+}
+
+// Two stable counting sorts, by inner and then by outer index, put the
+// triplets in storage order in O(nonzeros + rows + cols). Runs of the same
+// element are then summed into one
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, const std::vector<Triplet> &triplets,
+    S21SparseFormat format)
+    : S21BasicSparseMatrix(rows, cols, format) {
+  const bool csr = format_ == S21SparseFormat::kCSR;
+  const int count = static_cast<int>(triplets.size());
+  std::vector<int> outer(count), inner(count);
+  for (int k = 0; k != count; ++k) {
+    const Triplet &t = triplets[k];
+    if (t.row < 0 || t.row >= rows_ || t.col < 0 || t.col >= cols_)
+      throw std::invalid_argument("The element is outside the matrix.");
+    outer[k] = csr ? t.row : t.col;
+    inner[k] = csr ? t.col : t.row;
+  }
+  auto countingSort = [count](const std::vector<int> &keys, int range,
+                              const std::vector<int> &order) {
+    std::vector<int> starts(range + 1, 0), sorted(count);
+    for (int k = 0; k != count; ++k) ++starts[keys[k] + 1];
+    for (int o = 0; o != range; ++o) starts[o + 1] += starts[o];
+    for (int k : order) sorted[starts[keys[k]]++] = k;
+    return sorted;
+  };
+  std::vector<int> order(count);
+  for (int k = 0; k != count; ++k) order[k] = k;
+  order = countingSort(inner, Inner(), order);
+  order = countingSort(outer, Outer(), order);
+  int last = 0;
+  while (last != count) {
+    const int o = outer[order[last]], i = inner[order[last]];
+    T sum = 0;
+    for (; last != count && outer[order[last]] == o &&
+           inner[order[last]] == i;
+         ++last) {
+      sum += triplets[order[last]].value;
+    }
+    if (sum != 0) {
+      indices_.push_back(i);
+      values_.push_back(sum);
+      ++starts_[o + 1];
+    }
+  }
+  for (int o = 0; o != Outer(); ++o) starts_[o + 1] += starts_[o];
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    const S21BasicMatrixView<T> &dense, S21SparseFormat format)
+    : S21BasicSparseMatrix(dense.GetRows(), dense.GetCols(), format) {
+  const bool csr = format_ == S21SparseFormat::kCSR;
+  for (int o = 0; o != Outer(); ++o) {
+    for (int i = 0; i != Inner(); ++i) {
+      const T value = csr ? dense.Coeff(o, i) : dense.Coeff(i, o);
+      if (value != 0) {
+        indices_.push_back(i);
+        values_.push_back(value);
+      }
+    }
+    starts_[o + 1] = static_cast<int>(indices_.size());
+  }
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetRows() const { return rows_; }
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetCols() const { return cols_; }
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetNonZeros() const {
+  return static_cast<int>(values_.size());
+}
+
+template <typename T>
+S21SparseFormat S21BasicSparseMatrix<T>::GetFormat() const { return format_; }
+
+template <typename T>
+const std::vector<int> &S21BasicSparseMatrix<T>::GetStarts() const {
+  return starts_;
+}
+
+template <typename T>
+const std::vector<int> &S21BasicSparseMatrix<T>::GetIndices() const {
+  return indices_;
+}
+
+template <typename T>
+const std::vector<T> &S21BasicSparseMatrix<T>::GetValues() const {
+  return values_;
+}
+
+// Counting sort by inner index: walking the outer indices in order leaves
+// the new inner indices sorted
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToFormat(
+    S21SparseFormat format) const {
+  if (format == format_) return *this;
+  S21BasicSparseMatrix result(rows_, cols_, format);
+  const int nonZeros = GetNonZeros();
+  result.indices_.resize(nonZeros);
+  result.values_.resize(nonZeros);
+  for (int k = 0; k != nonZeros; ++k) ++result.starts_[indices_[k] + 1];
+  for (int i = 0; i != Inner(); ++i) {
+    result.starts_[i + 1] += result.starts_[i];
+  }
+  std::vector<int> next(result.starts_.begin(), result.starts_.end() - 1);
+  for (int o = 0; o != Outer(); ++o) {
+    for (int k = starts_[o]; k != starts_[o + 1]; ++k) {
+      const int dst = next[indices_[k]]++;
+      result.indices_[dst] = o;
+      result.values_[dst] = values_[k];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(rows_, cols_);
+  const bool csr = format_ == S21SparseFormat::kCSR;
+  const int rs = csr ? result.stride_ : 1, cs = csr ? 1 : result.stride_;
+  for (int o = 0; o != Outer(); ++o) {
+    for (int k = starts_[o]; k != starts_[o + 1]; ++k) {
+      result.matrix_[o * rs + indices_[k] * cs] = values_[k];
+    }
+  }
+  return result;
+}
+
+// Elements stored on one side only are compared with zero
+template <typename T>
+bool S21BasicSparseMatrix<T>::EqMatrix(
+    const S21BasicSparseMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  if (other.format_ != format_) return EqMatrix(other.ToFormat(format_));
+  auto near = [](T a, T b) {
+    return std::abs(a - b) < S21Tolerance<T>::kValue;
+  };
+  for (int o = 0; o != Outer(); ++o) {
+    int k = starts_[o], l = other.starts_[o];
+    const int kEnd = starts_[o + 1], lEnd = other.starts_[o + 1];
+    while (k != kEnd || l != lEnd) {
+      if (l == lEnd || (k != kEnd && indices_[k] < other.indices_[l])) {
+        if (!near(values_[k++], 0)) return false;
+      } else if (k == kEnd || other.indices_[l] < indices_[k]) {
+        if (!near(0, other.values_[l++])) return false;
+      } else if (!near(values_[k++], other.values_[l++])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SumMatrix(const S21BasicSparseMatrix &other) {
+  try {
+    if (rows_ != other.rows_ || cols_ != other.cols_)
+      throw std::invalid_argument("The sizes of matrices must match.");
+    Merge(other, 1);
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SubMatrix(const S21BasicSparseMatrix &other) {
+  try {
+    if (rows_ != other.rows_ || cols_ != other.cols_)
+      throw std::invalid_argument("The sizes of matrices must match.");
+    Merge(other, -1);
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+// this += sign * other by merging the sorted inner indices of every outer
+// index, elements that cancel out are dropped
+template <typename T>
+void S21BasicSparseMatrix<T>::Merge(const S21BasicSparseMatrix &other,
+                                    T sign) {
+  if (other.format_ != format_) {
+    Merge(other.ToFormat(format_), sign);
+    return;
+  }
+  std::vector<int> starts(Outer() + 1, 0), indices;
+  std::vector<T> values;
+  indices.reserve(indices_.size() + other.indices_.size());
+  values.reserve(indices.capacity());
+  auto push = [&](int index, T value) {
+    if (value != 0) {
+      indices.push_back(index);
+      values.push_back(value);
+    }
+  };
+  for (int o = 0; o != Outer(); ++o) {
+    int k = starts_[o], l = other.starts_[o];
+    const int kEnd = starts_[o + 1], lEnd = other.starts_[o + 1];
+    while (k != kEnd || l != lEnd) {
+      if (l == lEnd || (k != kEnd && indices_[k] < other.indices_[l])) {
+        push(indices_[k], values_[k]);
+        ++k;
+      } else if (k == kEnd || other.indices_[l] < indices_[k]) {
+        push(other.indices_[l], sign * other.values_[l]);
+        ++l;
+      } else {
+        push(indices_[k], values_[k] + sign * other.values_[l]);
+        ++k, ++l;
+      }
+    }
+    starts[o + 1] = static_cast<int>(indices.size());
+  }
+  starts_.swap(starts);
+  indices_.swap(indices);
+  values_.swap(values);
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::MulNumber(const T num) {
+  if (num == 0) {
+    std::fill(starts_.begin(), starts_.end(), 0);
+    indices_.clear();
+    values_.clear();
+  } else {
+    for (T &value : values_) value *= num;
+  }
+}
+
+// The product keeps the format of this matrix. Two CSC operands are
+// multiplied as the CSR product of their transposes, B^T * A^T = (A * B)^T
+template <typename T>
+void S21BasicSparseMatrix<T>::MulMatrix(const S21BasicSparseMatrix &other) {
+  try {
+    if (cols_ != other.rows_)
+      throw std::invalid_argument("Wrong matrices sizes for multiplication.");
+    if (other.format_ != format_) {
+      MulMatrix(other.ToFormat(format_));
+    } else if (format_ == S21SparseFormat::kCSR) {
+      *this = Gustavson(*this, other);
+    } else {
+      *this = Gustavson(other.Transpose(), Transpose()).Transpose();
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+// Row i of A * B is the sum of the rows k of B scaled by A(i, k). They are
+// accumulated in a dense row that remembers which columns it touched, so a
+// row costs as much as the multiply-adds it needs and not B's width
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Gustavson(
+    const S21BasicSparseMatrix &a, const S21BasicSparseMatrix &b) {
+  S21BasicSparseMatrix result(a.rows_, b.cols_);
+  std::vector<T> row(b.cols_, 0);
+  std::vector<int> touchedBy(b.cols_, -1), touched;
+  for (int i = 0; i != a.rows_; ++i) {
+    touched.clear();
+    for (int k = a.starts_[i]; k != a.starts_[i + 1]; ++k) {
+      const int p = a.indices_[k];
+      const T scale = a.values_[k];
+      for (int l = b.starts_[p]; l != b.starts_[p + 1]; ++l) {
+        const int j = b.indices_[l];
+        if (touchedBy[j] != i) {
+          touchedBy[j] = i;
+          touched.push_back(j);
+        }
+        row[j] += scale * b.values_[l];
+      }
+    }
+    std::sort(touched.begin(), touched.end());
+    for (int j : touched) {
+      if (row[j] != 0) {
+        result.indices_.push_back(j);
+        result.values_.push_back(row[j]);
+      }
+      row[j] = 0;
+    }
+    result.starts_[i + 1] = static_cast<int>(result.indices_.size());
+  }
+  return result;
+}
+
+// A dense operand that is not a plain row-major block is copied first, so
+// that its rows can go to the vector kernels
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::MulDense(
+    const S21BasicMatrixView<T> &dense, int threads) const {
+  S21BasicMatrix<T> result = S21BasicMatrix<T>();
+  try {
+    if (cols_ != dense.GetRows())
+      throw std::invalid_argument("Wrong matrices sizes for multiplication.");
+    if (!dense.IsBlock() || dense.IsTransposed())
+      return MulDense(S21BasicMatrix<T>(dense), threads);
+    result = S21BasicMatrix<T>(rows_, dense.GetCols());
+    if (format_ == S21SparseFormat::kCSR) {
+      MulDenseRows(dense, result, threads);
+    } else {
+      MulDenseCols(dense, result);
+    }
+  } catch (std::invalid_argument const &err) {
+    std::cout << err.what() << std::endl;
+    result.DeleteMatrix();
+  }
+  return result;
+}
+
+// Rows of a CSR product are independent, large products split them between
+// the threads of the pool
+template <typename T>
+void S21BasicSparseMatrix<T>::MulDenseRows(const S21BasicMatrixView<T> &dense,
+                                           S21BasicMatrix<T> &c,
+                                           int threads) const {
+  const int n = dense.GetCols();
+  auto body = [&](int begin, int end) {
+    for (int i = begin; i != end; ++i) {
+      T *dst = c.matrix_ + i * c.stride_;
+      for (int k = starts_[i]; k != starts_[i + 1]; ++k) {
+        const T *src = dense.GetData() + indices_[k] * dense.GetStride();
+        S21TypedKernels<T>::Axpy(n, values_[k], src, dst);
+      }
+    }
+  };
+  const long long work = static_cast<long long>(GetNonZeros()) * n;
+  if (threads == 1 || work < kSparseParallelWork) {
+    body(0, rows_);
+  } else {
+    const int grain = static_cast<int>(
+        std::max(1LL, kSparseParallelWork * rows_ / work));
+    S21ThreadPool::Instance().ParallelFor(rows_, grain, body, threads);
+  }
+}
+
+// Column j of a CSC matrix adds row j of the dense operand to the rows of
+// the product it has nonzeros in
+template <typename T>
+void S21BasicSparseMatrix<T>::MulDenseCols(const S21BasicMatrixView<T> &dense,
+                                           S21BasicMatrix<T> &c) const {
+  const int n = dense.GetCols();
+  for (int j = 0; j != cols_; ++j) {
+    const T *src = dense.GetData() + j * dense.GetStride();
+    for (int k = starts_[j]; k != starts_[j + 1]; ++k) {
+      T *dst = c.matrix_ + indices_[k] * c.stride_;
+      S21TypedKernels<T>::Axpy(n, values_[k], src, dst);
+    }
+  }
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  S21BasicSparseMatrix result(*this);
+  std::swap(result.rows_, result.cols_);
+  result.format_ = format_ == S21SparseFormat::kCSR ? S21SparseFormat::kCSC
+                                                    : S21SparseFormat::kCSR;
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicSparseMatrix &other) const {
+  S21BasicSparseMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator-(
+    const S21BasicSparseMatrix &other) const {
+  S21BasicSparseMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicSparseMatrix &other) const {
+  S21BasicSparseMatrix result(*this);
+  result.MulMatrix(other);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrixView<T> &dense) const {
+  return MulDense(dense);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(const T num) const {
+  S21BasicSparseMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+template <typename T>
+bool S21BasicSparseMatrix<T>::operator==(
+    const S21BasicSparseMatrix &other) const {
+  return EqMatrix(other);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator+=(
+    const S21BasicSparseMatrix &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator-=(
+    const S21BasicSparseMatrix &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator*=(
+    const S21BasicSparseMatrix &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator*=(const T num) {
+  MulNumber(num);
+  return *this;
+}
+
+template <typename T>
+T S21BasicSparseMatrix<T>::operator()(int row, int col) const {
+  CheckIndices(row, col);
+  const bool csr = format_ == S21SparseFormat::kCSR;
+  const int o = csr ? row : col, i = csr ? col : row;
+  const auto begin = indices_.begin() + starts_[o];
+  const auto end = indices_.begin() + starts_[o + 1];
+  const auto it = std::lower_bound(begin, end, i);
+  return it != end && *it == i ? values_[it - indices_.begin()] : 0;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::Outer() const {
+  return format_ == S21SparseFormat::kCSR ? rows_ : cols_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::Inner() const {
+  return format_ == S21SparseFormat::kCSR ? cols_ : rows_;
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::CheckIndices(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw std::invalid_argument("The element is outside the matrix.");
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<long double>;
@@ -0,0 +1,108 @@
+#ifndef S21_SPARSE_MATRIX_H
+#define S21_SPARSE_MATRIX_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Compressed sparse row (CSR) or column (CSC) layout
+enum class S21SparseFormat { kCSR, kCSC };
+
+// Element (row, col) of a sparse matrix given by its coordinates
+template <typename T>
+struct S21BasicTriplet {
+  int row, col;
+  T value;
+};
+
+// Sparse matrix that stores only its nonzero elements, so that memory and
+// the cost of every operation grow with their number instead of rows * cols.
+// Members are defined in s21_sparse_matrix.cc and instantiated there for
+// float, double and long double
+template <typename T>
+class S21BasicSparseMatrix {
+ private:
+  // Outer index o is a row in CSR and a column in CSC. Its elements are
+  // values_[k] for k in [starts_[o], starts_[o + 1]), indices_[k] holds their
+  // inner index (column in CSR, row in CSC). Inner indices are sorted and
+  // exact zeros are never stored
+  int rows_, cols_;
+  S21SparseFormat format_;
+  std::vector<int> starts_;
+  std::vector<int> indices_;
+  std::vector<T> values_;
+  int Outer() const;
+  int Inner() const;
+  void CheckIndices(int row, int col) const;
+  void Merge(const S21BasicSparseMatrix &other, T sign);
+  void MulDenseRows(const S21BasicMatrixView<T> &dense, S21BasicMatrix<T> &c,
+                    int threads) const;
+  void MulDenseCols(const S21BasicMatrixView<T> &dense,
+                    S21BasicMatrix<T> &c) const;
+  static S21BasicSparseMatrix Gustavson(const S21BasicSparseMatrix &a,
+                                        const S21BasicSparseMatrix &b);
+
+ public:
+  using value_type = T;
+  using Triplet = S21BasicTriplet<T>;
+
+  // Constructors, a new matrix of the given size has no nonzeros. Triplets
+  // may come in any order, duplicates are summed
+  S21BasicSparseMatrix();
+  S21BasicSparseMatrix(int rows, int cols,
+                       S21SparseFormat format = S21SparseFormat::kCSR);
+  S21BasicSparseMatrix(int rows, int cols, const std::vector<Triplet> &triplets,
+                       S21SparseFormat format = S21SparseFormat::kCSR);
+  explicit S21BasicSparseMatrix(const S21BasicMatrixView<T> &dense,
+                                S21SparseFormat format = S21SparseFormat::kCSR);
+
+  // Getters for private fields
+  int GetRows() const;
+  int GetCols() const;
+  int GetNonZeros() const;
+  S21SparseFormat GetFormat() const;
+  const std::vector<int> &GetStarts() const;
+  const std::vector<int> &GetIndices() const;
+  const std::vector<T> &GetValues() const;
+
+  // Conversions, changing the format is a counting sort in O(nonzeros + n)
+  S21BasicSparseMatrix ToFormat(S21SparseFormat format) const;
+  S21BasicMatrix<T> ToDense() const;
+
+  // Operations, operands of a different format are converted first
+  bool EqMatrix(const S21BasicSparseMatrix &other) const;
+  void SumMatrix(const S21BasicSparseMatrix &other);
+  void SubMatrix(const S21BasicSparseMatrix &other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicSparseMatrix &other);
+  // Sparse times dense, threads limits the thread pool for CSR matrices
+  S21BasicMatrix<T> MulDense(const S21BasicMatrixView<T> &dense,
+                             int threads = 0) const;
+  // Reinterprets CSR as CSC of the transpose and the other way round, no
+  // element is moved
+  S21BasicSparseMatrix Transpose() const;
+
+  // Operators
+  S21BasicSparseMatrix operator+(const S21BasicSparseMatrix &other) const;
+  S21BasicSparseMatrix operator-(const S21BasicSparseMatrix &other) const;
+  S21BasicSparseMatrix operator*(const S21BasicSparseMatrix &other) const;
+  S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &dense) const;
+  S21BasicSparseMatrix operator*(const T num) const;
+  bool operator==(const S21BasicSparseMatrix &other) const;
+  S21BasicSparseMatrix &operator+=(const S21BasicSparseMatrix &other);
+  S21BasicSparseMatrix &operator-=(const S21BasicSparseMatrix &other);
+  S21BasicSparseMatrix &operator*=(const S21BasicSparseMatrix &other);
+  S21BasicSparseMatrix &operator*=(const T num);
+  // Checked read, elements that are not stored are zero
+  T operator()(int row, int col) const;
+};
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+using S21SparseMatrixF = S21BasicSparseMatrix<float>;
+using S21SparseMatrixLD = S21BasicSparseMatrix<long double>;
+
+extern template class S21BasicSparseMatrix<float>;
+extern template class S21BasicSparseMatrix<double>;
+extern template class S21BasicSparseMatrix<long double>;
+
+#endif  // S21_SPARSE_MATRIX_H
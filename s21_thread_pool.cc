@@ -0,0 +1,130 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+// Set in threads running chunks, workers and the submitting thread alike, so
+// that nested ParallelFor calls run inline instead of locking submit_ again
+static thread_local bool tls_in_pool = false;
+
+// Sets tls_in_pool until the end of the scope
+class S21InPoolScope {
+ private:
+  bool saved_;
+
+ public:
+  S21InPoolScope() : saved_(std::exchange(tls_in_pool, true)) {}
+  S21InPoolScope(const S21InPoolScope &) = delete;
+  S21InPoolScope &operator=(const S21InPoolScope &) = delete;
+  ~S21InPoolScope() { tls_in_pool = saved_; }
+};
+
+S21ThreadPool::S21ThreadPool(int threads)
+    : body_(nullptr),
+      count_(0),
+      grain_(1),
+      next_(0),
+      helpers_(0),
+      threads_(1),
+      pending_(0),
+      generation_(0),
+      stop_(false) {
+  Start(threads);
+}
+
+S21ThreadPool::~S21ThreadPool() { Stop(); }
+
+S21ThreadPool &S21ThreadPool::Instance() {
+  static S21ThreadPool pool([] {
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    const char *env = std::getenv("S21_MATRIX_THREADS");
+    if (env && std::atoi(env) > 0) threads = std::atoi(env);
+    return threads;
+  }());
+  return pool;
+}
+
+int S21ThreadPool::GetThreads() const {
+  return threads_.load(std::memory_order_relaxed);
+}
+
+void S21ThreadPool::SetThreads(int threads) {
+  std::lock_guard<std::mutex> submit(submit_);
+  Stop();
+  Start(threads);
+}
+
+void S21ThreadPool::ParallelFor(int count, int grain,
+                                const std::function<void(int, int)> &body,
+                                int max_threads) {
+  if (grain < 1) grain = 1;
+  int threads = GetThreads();
+  if (max_threads > 0 && max_threads < threads) threads = max_threads;
+  if (count <= grain || threads < 2 || tls_in_pool || !submit_.try_lock()) {
+    if (count > 0) body(0, count);
+    return;
+  }
+  std::lock_guard<std::mutex> submit(submit_, std::adopt_lock);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    count_ = count;
+    grain_ = grain;
+    next_ = 0;
+    helpers_ = threads - 1;
+    pending_ = static_cast<int>(workers_.size());
+    ++generation_;
+  }
+  wake_.notify_all();
+  {
+    S21InPoolScope inPool;
+    RunChunks();
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return pending_ == 0; });
+  body_ = nullptr;
+}
+
+void S21ThreadPool::Start(int threads) {
+  stop_ = false;
+  for (int i = 1; i < threads; ++i) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this, generation_);
+  }
+  threads_ = static_cast<int>(workers_.size()) + 1;
+}
+
+void S21ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_) worker.join();
+  workers_.clear();
+  threads_ = 1;
+}
+
+// seen is the generation at spawn time, a job posted before the thread got
+// to run is still picked up
+void S21ThreadPool::WorkerLoop(unsigned long seen) {
+  tls_in_pool = true;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+    if (stop_) break;
+    seen = generation_;
+    lock.unlock();
+    // Only max_threads - 1 workers take part, the rest just acknowledge
+    if (helpers_.fetch_sub(1) > 0) RunChunks();
+    lock.lock();
+    if (--pending_ == 0) done_.notify_one();
+  }
+}
+
+void S21ThreadPool::RunChunks() {
+  for (int begin = next_.fetch_add(grain_); begin < count_;
+       begin = next_.fetch_add(grain_)) {
+    (*body_)(begin, std::min(begin + grain_, count_));
+  }
+}
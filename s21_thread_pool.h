@@ -0,0 +1,55 @@
+#ifndef S21_THREAD_POOL_H
+#define S21_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent pool of worker threads shared by the library. Workers sleep
+// between jobs, so a parallel operation costs a wake-up, not a thread spawn
+class S21ThreadPool {
+ private:
+  std::vector<std::thread> workers_;
+  std::mutex mutex_, submit_;
+  std::condition_variable wake_, done_;
+  // Current job, published under mutex_ and bumped generation_
+  const std::function<void(int, int)> *body_;
+  int count_, grain_;
+  std::atomic<int> next_, helpers_;
+  // Workers plus the calling thread, read without taking a lock
+  std::atomic<int> threads_;
+  int pending_;
+  unsigned long generation_;
+  bool stop_;
+  void Start(int threads);
+  void Stop();
+  void WorkerLoop(unsigned long seen);
+  void RunChunks();
+
+ public:
+  // threads counts the calling thread, so a pool of 1 runs everything inline
+  explicit S21ThreadPool(int threads);
+  S21ThreadPool(const S21ThreadPool &) = delete;
+  S21ThreadPool &operator=(const S21ThreadPool &) = delete;
+  ~S21ThreadPool();
+
+  // Pool used by S21Matrix. Its size is S21_MATRIX_THREADS from the
+  // environment or the number of hardware threads
+  static S21ThreadPool &Instance();
+
+  int GetThreads() const;
+  void SetThreads(int threads);
+
+  // Calls body(begin, end) on chunks of at least grain indices covering
+  // [0, count) using at most max_threads threads (0 means all of them).
+  // Returns when every chunk is done. body must not throw. Nested calls and
+  // calls made while the pool is busy run on the calling thread
+  void ParallelFor(int count, int grain,
+                   const std::function<void(int, int)> &body,
+                   int max_threads = 0);
+};
+
+#endif  // S21_THREAD_POOL_H
@@ -1,6 +1,70 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_band_matrix.h"
+#include "s21_buffer_pool.h"
+#include "s21_cholesky.h"
+#include "s21_fixed_matrix.h"
+#include "s21_kernels.h"
+#include "s21_lu.h"
 #include "s21_matrix_oop.h"
+#include "s21_packed_matrix.h"
+#include "s21_qr.h"
+#include "s21_scratch_arena.h"
+#include "s21_sparse_matrix.h"
+#include "s21_thread_pool.h"
+
+// Every heap allocation made by the test binary goes through this counter,
+// the size of the last aligned one is kept as well. The nothrow and array
+// forms forward to these. The deletes stay out of line: inlined at -O2, GCC
+// sees free() on a pointer from operator new and warns about the mismatch
+static std::atomic<long> allocations{0};
+static std::atomic<std::size_t> last_aligned_bytes{0};
+
+void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void *ptr,
+                                               std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  ++allocations;
+  last_aligned_bytes = size;
+  const std::size_t alignment = static_cast<std::size_t>(align);
+  const std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+  if (void *ptr = std::aligned_alloc(alignment, rounded ? rounded : alignment))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void *ptr,
+                                               std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void *ptr, std::size_t,
+                                               std::align_val_t) noexcept {
+  std::free(ptr);
+}
 
 // Constructors:
 
@@ -208,6 +272,24 @@ TEST(Setter, test10) {
   });
 }
 
+TEST(Setter, test11) {
+  S21Matrix test = S21Matrix(3, 3);
+  for (int i = 0; i < test.GetRows(); i++) {
+    for (int j = 0; j < test.GetCols(); j++) {
+      test(i, j) = i * 3 + j;
+    }
+  }
+  test.SetCols(5);
+  test.SetRows(2);
+  EXPECT_EQ(test.GetRows(), 2);
+  EXPECT_EQ(test.GetCols(), 5);
+  for (int i = 0; i < test.GetRows(); i++) {
+    for (int j = 0; j < test.GetCols(); j++) {
+      EXPECT_EQ(test(i, j), j < 3 ? i * 3 + j : 0);
+    }
+  }
+}
+
 // Operations
 
 TEST(EqMatrixTest, EqualMatrices) {
@@ -677,6 +759,91 @@ TEST(MulMatrixTest, MultiplyMatrixWrongSize) {
   }
 }
 
+TEST(MulMatrixTest, MultiplyLargeMatrices) {
+  S21Matrix mat1 = S21Matrix(130, 300);
+  S21Matrix mat2 = S21Matrix(300, 270);
+  for (int i = 0; i < mat1.GetRows(); i++) {
+    for (int j = 0; j < mat1.GetCols(); j++) {
+      mat1(i, j) = (i * 7 + j * 3) % 11 - 5;
+    }
+  }
+  for (int i = 0; i < mat2.GetRows(); i++) {
+    for (int j = 0; j < mat2.GetCols(); j++) {
+      mat2(i, j) = (i * 5 + j * 2) % 13 - 6;
+    }
+  }
+
+  S21Matrix result = mat1 * mat2;
+
+  EXPECT_EQ(result.GetRows(), 130);
+  EXPECT_EQ(result.GetCols(), 270);
+  for (int i = 0; i < result.GetRows(); i++) {
+    for (int j = 0; j < result.GetCols(); j++) {
+      double expected = 0;
+      for (int k = 0; k < mat1.GetCols(); k++) {
+        expected += mat1(i, k) * mat2(k, j);
+      }
+      EXPECT_EQ(result(i, j), expected);
+    }
+  }
+}
+
+// Fills a matrix with small integers so that products stay exact
+template <typename T = double>
+static S21BasicMatrix<T> Pattern(int rows, int cols, int seed) {
+  S21BasicMatrix<T> result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      result(i, j) = (i * seed + j * 3 + seed) % 7 - 3;
+    }
+  }
+  return result;
+}
+
+TEST(GemmTest, TransposedOperands) {
+  for (int size : {5, 90}) {
+    S21Matrix a = Pattern(size + 3, size, 2);
+    S21Matrix b = Pattern(size + 1, size + 3, 5);
+    S21Matrix c = Pattern(size, size + 1, 3);
+    S21Matrix expected = a.Transpose() * b.Transpose() * 2.0 + c * 3.0;
+
+    S21Matrix::Gemm(2.0, a, true, b, true, 3.0, c);
+
+    EXPECT_TRUE(c == expected);
+  }
+}
+
+TEST(GemmTest, AccumulateIntoDestination) {
+  S21Matrix a = Pattern(70, 80, 2), b = Pattern(70, 60, 4);
+  S21Matrix acc = S21Matrix(80, 60);
+
+  S21Matrix::Gemm(0.5, a, true, b, false, 1.0, acc);
+  S21Matrix::Gemm(0.5, a, true, b, false, 1.0, acc);
+
+  EXPECT_TRUE(acc == a.Transpose() * b);
+}
+
+TEST(GemmTest, DestinationIsOperand) {
+  S21Matrix a = Pattern(4, 4, 3), b = Pattern(4, 4, 6);
+  S21Matrix expected = a * b - a;
+
+  S21Matrix::Gemm(1.0, a, false, b, false, -1.0, a);
+
+  EXPECT_TRUE(a == expected);
+}
+
+TEST(GemmTest, WrongSizes) {
+  S21Matrix a = Pattern(2, 3, 1), b = Pattern(2, 3, 2), c = Pattern(2, 2, 3);
+  S21Matrix copy(c);
+
+  S21Matrix::Gemm(1.0, a, false, b, false, 0.0, c);
+  EXPECT_TRUE(c == copy);
+  S21Matrix::Gemm(1.0, a, true, b, false, 0.0, c);
+  EXPECT_TRUE(c == copy);
+  S21Matrix::Gemm(1.0, a, false, b, true, 0.0, c);
+  EXPECT_TRUE(c == a * b.Transpose());
+}
+
 TEST(TransposeTest, SquareMatrix) {
   double matrix[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
   double expected[3][3] = {{1, 4, 7}, {2, 5, 8}, {3, 6, 9}};
@@ -731,6 +898,77 @@ TEST(TransposeTest, SingleElementMatrix) {
   EXPECT_EQ(transposed(0, 0), expected[0][0]);
 }
 
+// Transpose with the plain loop, the reference for the blocked versions
+static S21Matrix NaiveTranspose(const S21Matrix &matrix) {
+  S21Matrix result(matrix.GetCols(), matrix.GetRows());
+  for (int i = 0; i != matrix.GetRows(); ++i) {
+    for (int j = 0; j != matrix.GetCols(); ++j) result(j, i) = matrix(i, j);
+  }
+  return result;
+}
+
+TEST(TransposeTest, LazyView) {
+  S21Matrix matrix = Pattern(5, 7, 3);
+  S21MatrixView transposed = matrix.Transposed();
+
+  EXPECT_EQ(transposed.GetRows(), 7);
+  EXPECT_EQ(transposed.GetCols(), 5);
+  EXPECT_EQ(transposed(6, 2), matrix(2, 6));
+  EXPECT_TRUE(transposed == NaiveTranspose(matrix));
+  EXPECT_TRUE(transposed.Block(1, 2, 3, 2) ==
+              NaiveTranspose(matrix).Block(1, 2, 3, 2));
+  EXPECT_TRUE(transposed.Minor(1, 4) == NaiveTranspose(matrix).Minor(1, 4));
+  EXPECT_TRUE(transposed.Transposed() == matrix);
+  EXPECT_TRUE(transposed.Transpose() == matrix);
+}
+
+TEST(TransposeTest, LazyOperands) {
+  for (int size : {6, 70}) {
+    S21Matrix a = Pattern(size + 2, size, 2), b = Pattern(size + 2, size, 5);
+    S21Matrix at = NaiveTranspose(a), bt = NaiveTranspose(b);
+
+    EXPECT_TRUE(a.Transposed() * b == at * b);
+    EXPECT_TRUE(a * b.Transposed() == a * bt);
+    EXPECT_TRUE(a.Transposed() * b.Transposed().Transposed() == at * b);
+
+    S21Matrix sum = a.Transposed() + bt * 2.0;
+    EXPECT_TRUE(sum == at + bt * 2.0);
+    sum.SubMatrix(b.Transposed());
+    sum.SumMatrix(a.Transposed());
+    EXPECT_TRUE(sum == at * 2.0 + bt);
+  }
+}
+
+TEST(TransposeTest, AssignOwnTranspose) {
+  S21Matrix matrix = Pattern(40, 40, 3);
+  S21Matrix expected = matrix + NaiveTranspose(matrix);
+
+  S21Matrix copy = matrix;
+  copy.SumMatrix(copy.Transposed());
+  EXPECT_TRUE(copy == expected);
+  matrix = matrix + matrix.Transposed();
+  EXPECT_TRUE(matrix == expected);
+  matrix = matrix.Transposed() * 2.0;
+  EXPECT_TRUE(matrix == expected * 2.0);
+}
+
+TEST(TransposeTest, BlockedAndInPlace) {
+  for (int rows : {1, 17, 67}) {
+    for (int cols : {1, 16, 131}) {
+      S21Matrix matrix = Pattern(rows, cols, 4);
+      S21Matrix expected = NaiveTranspose(matrix);
+
+      EXPECT_TRUE(matrix.Transpose() == expected);
+      matrix.TransposeInPlace();
+      EXPECT_TRUE(matrix == expected);
+    }
+  }
+  S21Matrix square = Pattern(77, 77, 6);
+  S21Matrix expected = NaiveTranspose(square);
+  square.TransposeInPlace();
+  EXPECT_TRUE(square == expected);
+}
+
 TEST(CalcComplementsTest, SquareMatrix1) {
   double matrix[2][2] = {{1, 2}, {3, 4}};
   double expected[2][2] = {{4, -3}, {-2, 1}};
@@ -809,6 +1047,35 @@ TEST(CalcComplementsTest, 1x1Matrix) {
   }
 }
 
+TEST(CalcComplementsTest, 4x4MatchesMinors) {
+  double matrix[4][4] = {
+      {3, -1, 2, 0}, {1, 4, -2, 5}, {0, 2, 1, -3}, {2, -1, 3, 1}};
+
+  S21Matrix mat = S21Matrix(4, 4);
+  for (int i = 0; i < mat.GetRows(); i++) {
+    for (int j = 0; j < mat.GetCols(); j++) {
+      mat(i, j) = matrix[i][j];
+    }
+  }
+
+  S21Matrix complements = mat.CalcComplements();
+
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      S21Matrix minor = S21Matrix(3, 3);
+      for (int r = 0, mr = 0; r < 4; r++) {
+        if (r == i) continue;
+        for (int c = 0, mc = 0; c < 4; c++) {
+          if (c != j) minor(mr, mc++) = matrix[r][c];
+        }
+        mr++;
+      }
+      double sign = (i + j) % 2 ? -1 : 1;
+      EXPECT_EQ(complements(i, j), sign * minor.Determinant());
+    }
+  }
+}
+
 TEST(DeterminantTest, 1x1Matrix) {
   double matrix[1][1] = {{42}};
 
@@ -868,6 +1135,69 @@ TEST(DeterminantTest, NonSquareMatrix) {
   EXPECT_EQ(determinant, 0);
 }
 
+TEST(DeterminantTest, EmptyMatrix) {
+  S21Matrix empty = S21Matrix(3, 2).InverseMatrix();
+  ASSERT_EQ(empty.GetRows(), 0);
+  EXPECT_EQ(empty.Determinant(), 0);
+  EXPECT_EQ(empty.View().Determinant(), 0);
+  EXPECT_EQ(empty.InverseMatrix().GetRows(), 0);
+  EXPECT_EQ(empty.CalcComplements().GetRows(), 0);
+}
+
+TEST(DeterminantTest, 4x4Matrix) {
+  double matrix[4][4] = {
+      {3, -1, 2, 0}, {1, 4, -2, 5}, {0, 2, 1, -3}, {2, -1, 3, 1}};
+
+  S21Matrix mat = S21Matrix(4, 4);
+  for (int i = 0; i < mat.GetRows(); i++) {
+    for (int j = 0; j < mat.GetCols(); j++) {
+      mat(i, j) = matrix[i][j];
+    }
+  }
+
+  EXPECT_EQ(mat.Determinant(), 141);
+  EXPECT_NEAR(S21LU(mat).Determinant(), 141, 1e-9);
+}
+
+TEST(DeterminantTest, 5x5MatchesCofactorExpansion) {
+  double matrix[5][5] = {{2, -1, 0, 3, 1},
+                         {4, 1, -2, 0, 5},
+                         {-3, 2, 7, 1, 0},
+                         {1, 0, 2, -4, 2},
+                         {0, 3, -1, 2, 6}};
+
+  S21Matrix mat = S21Matrix(5, 5);
+  for (int i = 0; i < mat.GetRows(); i++) {
+    for (int j = 0; j < mat.GetCols(); j++) {
+      mat(i, j) = matrix[i][j];
+    }
+  }
+
+  EXPECT_NEAR(mat.Determinant(), -1041, 1e-9);
+}
+
+TEST(DeterminantTest, LargeTriangularMatrix) {
+  S21Matrix mat = S21Matrix(40, 40);
+  for (int i = 0; i < mat.GetRows(); i++) {
+    for (int j = i; j < mat.GetCols(); j++) {
+      mat(i, j) = (i == j) ? (i % 2 ? 2.0 : 0.5) : i + j;
+    }
+  }
+
+  EXPECT_NEAR(mat.Determinant(), 1.0, 1e-9);
+}
+
+TEST(DeterminantTest, SingularMatrix) {
+  S21Matrix mat = S21Matrix(6, 6);
+  for (int i = 0; i < mat.GetRows(); i++) {
+    for (int j = 0; j < mat.GetCols(); j++) {
+      mat(i, j) = i * 6 + j;
+    }
+  }
+
+  EXPECT_NEAR(mat.Determinant(), 0, 1e-7);
+}
+
 TEST(InverseTest, 1x1Matrix) {
   S21Matrix mat = S21Matrix(1, 1);
   mat(0, 0) = 2.0;
@@ -913,6 +1243,65 @@ TEST(InverseTest, 3x3MatrixZeroDeterminant) {
   EXPECT_EQ(inversed.GetCols(), 0);
 }
 
+TEST(InverseTest, 2x2And4x4Matrices) {
+  for (int size : {2, 4}) {
+    S21Matrix mat = S21Matrix(size, size);
+    for (int i = 0; i < mat.GetRows(); i++) {
+      for (int j = 0; j < mat.GetCols(); j++) {
+        mat(i, j) = (i == j) ? 4 + i : (i * 3 + j) % 4 - 1;
+      }
+    }
+
+    S21Matrix identity = mat.InverseMatrix() * mat;
+
+    for (int i = 0; i < identity.GetRows(); i++) {
+      for (int j = 0; j < identity.GetCols(); j++) {
+        EXPECT_NEAR(identity(i, j), i == j ? 1.0 : 0.0, 1e-12);
+      }
+    }
+  }
+}
+
+TEST(InverseTest, 6x6Matrix) {
+  S21Matrix mat = S21Matrix(6, 6);
+  for (int i = 0; i < mat.GetRows(); i++) {
+    for (int j = 0; j < mat.GetCols(); j++) {
+      mat(i, j) = (i == j) ? 10 + i : (i * 7 + j * 3) % 5 - 2;
+    }
+  }
+
+  S21Matrix identity = mat * mat.InverseMatrix();
+
+  for (int i = 0; i < identity.GetRows(); i++) {
+    for (int j = 0; j < identity.GetCols(); j++) {
+      EXPECT_NEAR(identity(i, j), i == j ? 1.0 : 0.0, 1e-12);
+    }
+  }
+}
+
+TEST(InverseTest, 5x5MatrixZeroDeterminant) {
+  S21Matrix mat = S21Matrix(5, 5);
+  for (int i = 0; i < mat.GetRows(); i++) {
+    for (int j = 0; j < mat.GetCols(); j++) {
+      mat(i, j) = i + j;
+    }
+  }
+
+  S21Matrix inversed = mat.InverseMatrix();
+
+  EXPECT_EQ(inversed.GetRows(), 0);
+  EXPECT_EQ(inversed.GetCols(), 0);
+}
+
+TEST(InverseTest, NonSquareMatrix) {
+  S21Matrix mat = S21Matrix(2, 3);
+
+  S21Matrix inversed = mat.InverseMatrix();
+
+  EXPECT_EQ(inversed.GetRows(), 0);
+  EXPECT_EQ(inversed.GetCols(), 0);
+}
+
 // Operators
 
 TEST(AssignmentOperator, test1) {
@@ -1044,6 +1433,117 @@ TEST(MultiplicationOperator, MultiplyMatrixArbitrary) {
   }
 }
 
+TEST(ExpressionOperators, FusedExpression) {
+  S21Matrix a = S21Matrix(3, 4), b = S21Matrix(3, 4), c = S21Matrix(3, 4);
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < a.GetCols(); j++) {
+      a(i, j) = i + j;
+      b(i, j) = i * j;
+      c(i, j) = i - j;
+    }
+  }
+
+  S21Matrix result = a + b - c * 2.0 + 0.5 * a;
+  const S21Matrix constA(a);
+  S21Matrix sum = constA + b;
+
+  for (int i = 0; i < result.GetRows(); i++) {
+    for (int j = 0; j < result.GetCols(); j++) {
+      EXPECT_EQ(result(i, j), 1.5 * (i + j) + i * j - 2.0 * (i - j));
+      EXPECT_EQ(sum(i, j), i + j + i * j);
+    }
+  }
+}
+
+TEST(ExpressionOperators, AssignToOperand) {
+  S21Matrix a = S21Matrix(2, 2), b = S21Matrix(2, 2);
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < a.GetCols(); j++) {
+      a(i, j) = i * 2 + j;
+      b(i, j) = 1;
+    }
+  }
+
+  a = b - a * 3.0;
+  b = b + b;
+
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < a.GetCols(); j++) {
+      EXPECT_EQ(a(i, j), 1 - 3 * (i * 2 + j));
+      EXPECT_EQ(b(i, j), 2);
+    }
+  }
+}
+
+TEST(ExpressionOperators, MismatchKeepsLeftOperand) {
+  S21Matrix a = S21Matrix(2, 3), b = S21Matrix(3, 2), c = S21Matrix(2, 3);
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < a.GetCols(); j++) {
+      a(i, j) = i + j;
+      c(i, j) = 1;
+    }
+  }
+
+  S21Matrix result = S21Matrix(3, 3);
+  result = a + b - c;
+
+  EXPECT_EQ(result.GetRows(), 2);
+  EXPECT_EQ(result.GetCols(), 3);
+  for (int i = 0; i < result.GetRows(); i++) {
+    for (int j = 0; j < result.GetCols(); j++) {
+      EXPECT_EQ(result(i, j), i + j - 1);
+    }
+  }
+}
+
+TEST(ExpressionOperators, ProductAndComparison) {
+  S21Matrix a = S21Matrix(2, 2), identity = S21Matrix(2, 2);
+  a(0, 0) = 1;
+  a(0, 1) = 2;
+  a(1, 0) = 3;
+  a(1, 1) = 4;
+  identity(0, 0) = identity(1, 1) = 1;
+
+  S21Matrix product = (a + identity) * (identity * 2.0);
+
+  EXPECT_TRUE(product == (a + identity) * 2.0);
+  EXPECT_TRUE(a * 2.0 == a + a);
+  EXPECT_FALSE(a - a == a);
+}
+
+TEST(ExpressionOperators, TemporaryOperands) {
+  S21Matrix a = Pattern(3, 3, 1), b = Pattern(3, 3, 2);
+  S21Matrix expected = (a * b) * 2.0 - a + b;
+
+  S21Matrix left = a * b * 2.0 - a + b;
+  S21Matrix right = b - (a - a * b * 2.0);
+  S21Matrix both = a * b * 2.0 + (b - a);
+  S21Matrix mismatch = S21Matrix(a) + S21Matrix(2, 3);
+
+  EXPECT_TRUE(left == expected);
+  EXPECT_TRUE(right == expected);
+  EXPECT_TRUE(both == expected);
+  EXPECT_TRUE(mismatch == a);
+}
+
+TEST(ExpressionOperators, TemporariesReuseStorage) {
+  S21Matrix a = Pattern(8, 8, 1), b = Pattern(8, 8, 2);
+  S21Matrix expected = S21Matrix(a * 2.0) + b - a * 0.5;
+
+  long before = allocations;
+  S21Matrix chain = 2.0 * S21Matrix(a) + b - a * 0.5;
+  EXPECT_EQ(allocations - before, 1);
+
+  S21Matrix sum(8, 8);
+  before = allocations;
+  ((sum += a) -= a) *= 3.0;
+  sum += b;
+  EXPECT_EQ(allocations, before);
+
+  EXPECT_TRUE(chain == expected);
+  EXPECT_TRUE(sum == b);
+}
+
 TEST(EqualityOperator, EqualMatrices) {
   double matrix1[2][2] = {{1, 2}, {3, 4}};
   double matrix2[2][2] = {{1, 2}, {3, 4}};
@@ -1226,10 +1726,1127 @@ TEST(IndexationOperator, Indexation_Improper_Bounds_Const) {
   }
   const S21Matrix mat_const = mat1;
 
-  EXPECT_ANY_THROW(mat_const(3, 1) = 0);
-  EXPECT_ANY_THROW(mat_const(1, 5) = 0);
-  EXPECT_ANY_THROW(mat_const(-3, 1) = 0);
-  EXPECT_ANY_THROW(mat_const(1, -5) = 0);
+  EXPECT_ANY_THROW(mat_const(3, 1));
+  EXPECT_ANY_THROW(mat_const(1, 5));
+  EXPECT_ANY_THROW(mat_const(-3, 1));
+  EXPECT_ANY_THROW(mat_const(1, -5));
+}
+
+// Fixed-size matrices
+
+template <typename A, typename B, typename = void>
+struct CanMultiply : std::false_type {};
+
+template <typename A, typename B>
+struct CanMultiply<
+    A, B, std::void_t<decltype(std::declval<A>() * std::declval<B>())>>
+    : std::true_type {};
+
+template <typename A, typename B, typename = void>
+struct CanAdd : std::false_type {};
+
+template <typename A, typename B>
+struct CanAdd<A, B,
+              std::void_t<decltype(std::declval<A>() + std::declval<B>())>>
+    : std::true_type {};
+
+TEST(FixedMatrixTest, CompileTimeEvaluation) {
+  constexpr S21FixedMatrix<2, 3> a({{1, 2, 3}, {4, 5, 6}});
+  constexpr S21FixedMatrix<3, 2> b({{3, 0}, {2, 1}, {0, 1}});
+  constexpr S21FixedMatrix<2, 2> product = a * b;
+  constexpr S21FixedMatrix<4, 4> m(
+      {{3, -1, 2, 0}, {1, 4, -2, 5}, {0, 2, 1, -3}, {2, -1, 3, 1}});
+
+  static_assert(product(0, 0) == 7 && product(0, 1) == 5);
+  static_assert(product(1, 0) == 22 && product(1, 1) == 11);
+  static_assert(a.Transpose()(2, 1) == 6);
+  static_assert(product.Determinant() == -33);
+  static_assert(m.Determinant() > 140.999 && m.Determinant() < 141.001);
+  static_assert(S21FixedMatrix<3, 2>::GetRows() == 3);
+  static_assert((a + a * 2.0)(1, 2) == 18);
+  constexpr S21FixedMatrix<4, 4> identity(
+      {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}});
+  static_assert(m * m.InverseMatrix() == identity);
+}
+
+TEST(FixedMatrixTest, SizesCheckedAtCompileTime) {
+  using M23 = S21FixedMatrix<2, 3>;
+  using M32 = S21FixedMatrix<3, 2>;
+  EXPECT_TRUE((CanMultiply<M23, M32>::value));
+  EXPECT_FALSE((CanMultiply<M23, M23>::value));
+  EXPECT_TRUE((CanAdd<M23, M23>::value));
+  EXPECT_FALSE((CanAdd<M23, M32>::value));
+}
+
+TEST(FixedMatrixTest, ConversionsWithS21Matrix) {
+  S21Matrix dynamic = S21Matrix(2, 2);
+  dynamic(0, 0) = 4;
+  dynamic(0, 1) = 7;
+  dynamic(1, 0) = 2;
+  dynamic(1, 1) = 6;
+
+  S21FixedMatrix<2, 2> fixed(dynamic);
+  fixed *= 2.0;
+  S21Matrix back = static_cast<S21Matrix>(fixed.InverseMatrix());
+
+  EXPECT_TRUE(back == dynamic.InverseMatrix() * 0.5);
+  EXPECT_ANY_THROW((S21FixedMatrix<2, 3>(dynamic)));
+  using M22 = S21FixedMatrix<2, 2>;
+  EXPECT_ANY_THROW(M22().InverseMatrix());
+}
+
+// SIMD kernels
+
+TEST(KernelsTest, VectorKernelsMatchScalar) {
+  const S21Kernels *scalar = S21FindKernels("scalar");
+  ASSERT_NE(scalar, nullptr);
+  const int m = 13, n = 37, k = 29;
+  std::vector<double> a(m * k), b(k * n), c(m * n);
+  for (int i = 0; i < m * k; i++) a[i] = (i * 7 % 19) / 3.0 - 2;
+  for (int i = 0; i < k * n; i++) b[i] = (i * 5 % 23) / 4.0 - 3;
+  for (int i = 0; i < m * n; i++) c[i] = (i * 3 % 11) / 2.0;
+  for (const char *name : {"avx2", "avx512"}) {
+    const S21Kernels *kernels = S21FindKernels(name);
+    if (kernels == nullptr) continue;
+    std::vector<double> expected(c), actual(c);
+    scalar->gemm(m, n, k, a.data(), k, b.data(), n, expected.data(), n);
+    kernels->gemm(m, n, k, a.data(), k, b.data(), n, actual.data(), n);
+    scalar->axpy(m * n, 0.5, c.data(), expected.data());
+    kernels->axpy(m * n, 0.5, c.data(), actual.data());
+    scalar->add(m * n - 1, c.data(), expected.data() + 1);
+    kernels->add(m * n - 1, c.data(), actual.data() + 1);
+    scalar->sub(m * n - 3, c.data() + 3, expected.data());
+    kernels->sub(m * n - 3, c.data() + 3, actual.data());
+    scalar->scale(m * n, -1.5, expected.data());
+    kernels->scale(m * n, -1.5, actual.data());
+    for (int i = 0; i < m * n; i++) {
+      EXPECT_NEAR(actual[i], expected[i], 1e-9) << name << " at " << i;
+    }
+  }
+}
+
+TEST(KernelsTest, UnknownKernels) {
+  EXPECT_EQ(S21FindKernels("sse1"), nullptr);
+  EXPECT_NE(S21ActiveKernels().name, nullptr);
+}
+
+// Thread pool
+
+TEST(ThreadPoolTest, CoversEveryIndexOnce) {
+  S21ThreadPool pool(4);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.ParallelFor(1000, 7, [&](int begin, int end) {
+    for (int i = begin; i < end; i++) hits[i]++;
+  });
+  for (int i = 0; i < 1000; i++) EXPECT_EQ(hits[i], 1);
+  EXPECT_EQ(pool.GetThreads(), 4);
+}
+
+TEST(ThreadPoolTest, NestedAndLimitedCalls) {
+  S21ThreadPool pool(3);
+  std::atomic<int> total(0);
+  pool.ParallelFor(
+      10, 1,
+      [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          pool.ParallelFor(10, 1, [&](int b, int e) { total += e - b; });
+        }
+      },
+      2);
+  EXPECT_EQ(total, 100);
+  pool.SetThreads(1);
+  EXPECT_EQ(pool.GetThreads(), 1);
+  pool.ParallelFor(5, 1, [&](int begin, int end) { total += end - begin; });
+  EXPECT_EQ(total, 105);
+}
+
+TEST(ThreadPoolTest, NestedCallsStayOnTheirThread) {
+  S21ThreadPool pool(4);
+  std::atomic<int> inline_calls(0), total(0);
+  pool.ParallelFor(40, 1, [&](int begin, int end) {
+    const std::thread::id outer = std::this_thread::get_id();
+    pool.ParallelFor(100, 1, [&](int b, int e) {
+      if (std::this_thread::get_id() == outer) ++inline_calls;
+      total += e - b;
+    });
+    total += end - begin;
+  });
+  EXPECT_EQ(total, 4040);
+  EXPECT_EQ(inline_calls, 40);
+
+  std::atomic<bool> done(false);
+  std::thread reader([&] {
+    while (!done) {
+      const int threads = pool.GetThreads();
+      EXPECT_TRUE(threads >= 1 && threads <= 4);
+    }
+  });
+  for (int threads : {2, 3, 1, 4}) pool.SetThreads(threads);
+  done = true;
+  reader.join();
+  EXPECT_EQ(pool.GetThreads(), 4);
+}
+
+TEST(MulMatrixTest, ParallelMatchesSerial) {
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  const int threads = pool.GetThreads();
+  pool.SetThreads(4);
+  S21Matrix mat1 = S21Matrix(300, 200);
+  S21Matrix mat2 = S21Matrix(200, 600);
+  for (int i = 0; i < mat1.GetRows(); i++) {
+    for (int j = 0; j < mat1.GetCols(); j++) {
+      mat1(i, j) = (i * 7 + j * 3) % 11 - 5;
+    }
+  }
+  for (int i = 0; i < mat2.GetRows(); i++) {
+    for (int j = 0; j < mat2.GetCols(); j++) {
+      mat2(i, j) = (i * 5 + j * 2) % 13 - 6;
+    }
+  }
+
+  S21Matrix serial(mat1), parallel(mat1);
+  serial.MulMatrix(mat2, 1);
+  parallel.MulMatrix(mat2);
+  pool.SetThreads(threads);
+
+  EXPECT_TRUE(serial == parallel);
+}
+
+// LU factorization
+
+TEST(LUTest, SolveMultipleRightHandSides) {
+  double matrix[4][4] = {
+      {0, 2, 1, 4}, {1, 1, 0, 3}, {2, 0, 3, 1}, {3, 4, 1, 0}};
+  double solution[4][2] = {{1, -2}, {2, 0.5}, {-1, 3}, {0.25, 1}};
+
+  S21Matrix a = S21Matrix(4, 4);
+  S21Matrix x = S21Matrix(4, 2);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) a(i, j) = matrix[i][j];
+    for (int j = 0; j < 2; j++) x(i, j) = solution[i][j];
+  }
+
+  S21LU lu(a);
+  S21Matrix solved = lu.Solve(a * x);
+
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_EQ(solved.GetRows(), 4);
+  EXPECT_EQ(solved.GetCols(), 2);
+  for (int i = 0; i < solved.GetRows(); i++) {
+    for (int j = 0; j < solved.GetCols(); j++) {
+      EXPECT_NEAR(solved(i, j), solution[i][j], 1e-12);
+    }
+  }
+}
+
+TEST(LUTest, DeterminantAndInverse) {
+  double matrix[3][3] = {{2, 5, 7}, {6, 3, 4}, {5, -2, -3}};
+  double result[3][3] = {{1, -1, 1}, {-38, 41, -34}, {27, -29, 24}};
+
+  S21Matrix a = S21Matrix(3, 3);
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < a.GetCols(); j++) {
+      a(i, j) = matrix[i][j];
+    }
+  }
+
+  S21LU lu(a);
+  S21Matrix inversed = lu.Inverse();
+
+  EXPECT_NEAR(lu.Determinant(), -1, 1e-12);
+  for (int i = 0; i < inversed.GetRows(); i++) {
+    for (int j = 0; j < inversed.GetCols(); j++) {
+      EXPECT_NEAR(inversed(i, j), result[i][j], 1e-10);
+    }
+  }
+}
+
+TEST(LUTest, SingularMatrix) {
+  double matrix[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+
+  S21Matrix a = S21Matrix(3, 3);
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < a.GetCols(); j++) {
+      a(i, j) = matrix[i][j];
+    }
+  }
+
+  S21LU lu(a);
+  S21Matrix solved = lu.Solve(S21Matrix(3, 1));
+
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_NEAR(lu.Determinant(), 0, 1e-7);
+  EXPECT_EQ(solved.GetRows(), 0);
+  EXPECT_EQ(solved.GetCols(), 0);
+}
+
+TEST(LUTest, WrongSizes) {
+  EXPECT_ANY_THROW(S21LU lu(S21Matrix(2, 3)));
+
+  S21LU lu(S21Matrix(3, 3));
+  S21Matrix solved = lu.Solve(S21Matrix(2, 1));
+
+  EXPECT_EQ(solved.GetRows(), 0);
+  EXPECT_EQ(solved.GetCols(), 0);
+}
+
+TEST(BufferPoolTest, ScopeReusesBlocks) {
+  S21BufferPool &pool = S21BufferPool::Instance();
+  const S21BufferPool::Stats start = pool.GetStats();
+  { S21Matrix dropped(10, 10); }
+  EXPECT_EQ(pool.GetStats().cached_blocks, start.cached_blocks);
+
+  S21BufferPoolScope scope;
+  { S21Matrix dropped = Pattern(10, 10, 1); }
+  EXPECT_EQ(pool.GetStats().cached_blocks, start.cached_blocks + 1);
+  const long before = allocations;
+  S21Matrix reused(10, 11);
+  EXPECT_EQ(allocations, before);
+  EXPECT_EQ(pool.GetStats().hits, start.hits + 1);
+  for (int i = 0; i < 10; i++) EXPECT_EQ(reused(i, i), 0);
+  pool.Trim();
+}
+
+TEST(BufferPoolTest, RoundsOnlyWhenEnabled) {
+  S21BufferPool &pool = S21BufferPool::Instance();
+  const std::size_t bytes = 100 * 100 * sizeof(double);
+  const long cached = pool.GetStats().cached_blocks;
+  S21Matrix exact(100, 100);
+  EXPECT_EQ(last_aligned_bytes, bytes);
+  {
+    S21BufferPoolScope scope;
+    S21Matrix rounded(100, 100);
+    EXPECT_EQ(last_aligned_bytes, 81920u);
+    // A block of the exact size does not fit its class and is not kept
+    exact = S21Matrix();
+    EXPECT_EQ(pool.GetStats().cached_blocks, cached);
+  }
+  pool.Trim();
+}
+
+TEST(BufferPoolTest, ProcessWideAcrossThreads) {
+  S21BufferPool &pool = S21BufferPool::Instance();
+  pool.SetEnabled(true);
+  // The exiting thread hands its cache to the shared bins
+  std::thread([] { S21Matrix dropped(20, 20); }).join();
+  const long hits = pool.GetStats().hits;
+  S21Matrix matrix(20, 20);
+  pool.SetEnabled(false);
+
+  EXPECT_EQ(pool.GetStats().hits, hits + 1);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&matrix(0, 0)) %
+                S21BufferPool::kAlignment,
+            0u);
+  pool.Trim();
+}
+
+TEST(BufferPoolTest, TrimAndLargeBlocks) {
+  S21BufferPool &pool = S21BufferPool::Instance();
+  S21BufferPoolScope scope;
+  {
+    S21Matrix first(30, 30), second(30, 30), third(30, 30);
+    S21MatrixF small(5, 5);
+  }
+  EXPECT_GE(pool.GetStats().cached_blocks, 4);
+  EXPECT_GE(pool.GetStats().cached_bytes, 3 * 30 * 30 * 8 + 25 * 4);
+  pool.Trim();
+  EXPECT_EQ(pool.GetStats().cached_blocks, 0);
+  EXPECT_EQ(pool.GetStats().cached_bytes, 0);
+
+  const int side = 3000;  // 72 MB, above kMaxPooledBytes
+  { S21Matrix huge(side, side); }
+  EXPECT_EQ(pool.GetStats().cached_blocks, 0);
+}
+
+TEST(CopyOnWriteTest, CopiesShareUntilWritten) {
+  S21Matrix a = Pattern(8, 8, 1);
+  const S21Matrix original = a;
+  EXPECT_FALSE(a.IsShared());
+  a.SetCopyOnWrite(true);
+
+  const long before = allocations;
+  S21Matrix b(a), c = a, d;
+  d = a;
+  EXPECT_EQ(allocations, before);
+  EXPECT_TRUE(a.IsShared());
+  EXPECT_TRUE(b.IsCopyOnWrite());
+  EXPECT_FALSE(d.IsCopyOnWrite());
+
+  // b and c are copy-on-write too, each gets a block and its count
+  b(0, 0) = 100;
+  c.SumMatrix(a);
+  EXPECT_EQ(allocations - before, 4);
+  EXPECT_EQ(std::as_const(b)(0, 0), 100);
+  EXPECT_TRUE(c == original * 2.0);
+  EXPECT_TRUE(a == original);
+  EXPECT_TRUE(d == original);
+  EXPECT_TRUE(a.IsShared());
+}
+
+TEST(CopyOnWriteTest, OnlySharedBlocksAreCounted) {
+  S21Matrix plain(1024, 1024);
+  EXPECT_EQ(last_aligned_bytes, 1024u * 1024 * sizeof(double));
+  S21Matrix shared(8, 8);
+  shared.SetCopyOnWrite(true);
+  shared = Pattern(9, 9, 2) * 2.0;
+  const long before = allocations;
+  S21Matrix copy = shared;
+  EXPECT_EQ(allocations, before);
+  EXPECT_TRUE(shared.IsShared());
+  EXPECT_TRUE(copy == Pattern(9, 9, 2) * 2.0);
+}
+
+TEST(CopyOnWriteTest, EveryChangeDetaches) {
+  void (*changes[])(S21Matrix &) = {
+      [](S21Matrix &m) { m(1, 2) = 7; },
+      [](S21Matrix &m) { m.SumMatrix(m); },
+      [](S21Matrix &m) { m -= m; },
+      [](S21Matrix &m) { m.MulNumber(2); },
+      [](S21Matrix &m) { m *= m; },
+      [](S21Matrix &m) { m.TransposeInPlace(); },
+      [](S21Matrix &m) { m.SetRows(7); },
+      [](S21Matrix &m) { m = m * 2.0 + m; },
+      [](S21Matrix &m) { S21Matrix::Gemm(1, m, false, m, false, 1, m); },
+  };
+  const S21Matrix original = Pattern(6, 6, 2);
+  for (auto change : changes) {
+    S21Matrix a = original;
+    a.SetCopyOnWrite(true);
+    S21Matrix copy = a;
+    change(copy);
+    EXPECT_TRUE(a == original);
+    EXPECT_FALSE(copy == original);
+    EXPECT_FALSE(a.IsShared());
+  }
+}
+
+TEST(CopyOnWriteTest, SharedAcrossThreads) {
+  S21Matrix a = Pattern(64, 64, 3);
+  const S21Matrix expected = a;
+  a.SetCopyOnWrite(true);
+  std::atomic<int> unchanged(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([a, t, &expected, &unchanged]() mutable {
+      if (t % 2) a(t, t) += 1;
+      if (a == expected) ++unchanged;
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+
+  EXPECT_EQ(unchanged, 2);
+  EXPECT_FALSE(a.IsShared());
+  EXPECT_TRUE(a == expected);
+}
+
+TEST(ElementAccessTest, IndexEqualToSizeThrows) {
+  S21Matrix mat(2, 3);
+  const S21Matrix &mat_const = mat;
+  EXPECT_NO_THROW(mat(1, 2) = 1);
+  EXPECT_ANY_THROW(mat(2, 0) = 1);
+  EXPECT_ANY_THROW(mat(0, 3) = 1);
+  EXPECT_ANY_THROW(mat_const(2, 2));
+  EXPECT_ANY_THROW(mat_const(1, 3));
+}
+
+TEST(ElementAccessTest, UncheckedAccessors) {
+  S21Matrix mat = Pattern(5, 7, 4);
+  const S21Matrix &mat_const = mat;
+  for (int i = 0; i < 5; i++) {
+    S21Span<const double> row = mat_const.Row(i);
+    ASSERT_EQ(row.size(), 7);
+    for (int j = 0; j < 7; j++) {
+      EXPECT_EQ(mat_const.At(i, j), mat_const(i, j));
+      EXPECT_EQ(row[j], mat_const(i, j));
+      EXPECT_EQ(mat_const.data()[i * 7 + j], mat_const(i, j));
+    }
+  }
+  mat.At(1, 2) = 10;
+  for (double &value : mat.Row(4)) value = -1;
+  EXPECT_EQ(mat_const(1, 2), 10);
+  EXPECT_EQ(mat_const(4, 0), -1);
+  EXPECT_EQ(mat_const(4, 6), -1);
+  EXPECT_EQ(mat_const(3, 6), Pattern(5, 7, 4)(3, 6));
+}
+
+#ifdef S21_MATRIX_DEBUG
+TEST(ElementAccessTest, DebugBuildChecksIndices) {
+  S21Matrix mat(2, 3);
+  const S21Matrix &mat_const = mat;
+  EXPECT_ANY_THROW(mat.At(2, 0) = 1);
+  EXPECT_ANY_THROW(mat_const.At(0, -1));
+  EXPECT_ANY_THROW(mat.Row(2));
+  EXPECT_ANY_THROW(mat.Row(1)[3] = 1);
+  EXPECT_NO_THROW(mat.Row(1)[2] = 1);
+}
+#endif
+
+TEST(ElementAccessTest, StandardAlgorithms) {
+  const S21Matrix a = Pattern(6, 9, 5), b = Pattern(6, 9, 6);
+  S21Matrix sum(6, 9);
+  std::transform(a.begin(), a.end(), b.begin(), sum.begin(),
+                 std::plus<double>());
+  EXPECT_TRUE(sum == a + b);
+  EXPECT_EQ(std::distance(a.cbegin(), a.cend()), 54);
+  EXPECT_DOUBLE_EQ(std::accumulate(a.begin(), a.end(), 0.0),
+                   std::accumulate(a.Row(0).begin(), a.Row(0).end(), 0.0) +
+                       std::accumulate(a.begin() + 9, a.end(), 0.0));
+
+  S21Matrix shared = a;
+  shared.SetCopyOnWrite(true);
+  S21Matrix copy = shared;
+  std::fill(copy.begin(), copy.end(), 0.0);
+  std::sort(shared.Row(2).begin(), shared.Row(2).end());
+  EXPECT_TRUE(std::is_sorted(std::as_const(shared).Row(2).begin(),
+                             std::as_const(shared).Row(2).end()));
+  EXPECT_TRUE(copy == S21Matrix(6, 9));
+  EXPECT_TRUE(shared.RowRange(3, 3) == a.RowRange(3, 3));
+}
+
+TEST(SmallMatrixTest, NoHeapAllocations) {
+  S21Matrix a = Pattern(4, 4, 1), b = Pattern(4, 4, 3);
+  S21Matrix sum(4, 4);
+
+  const long before = allocations;
+  {
+    S21Matrix moved = std::move(a);
+    S21Matrix product = moved * b;
+    sum = product + b * 2.0;
+    sum.Determinant();
+    sum = sum.CalcComplements();
+  }
+  EXPECT_EQ(allocations, before);
+}
+
+TEST(SmallMatrixTest, MoveCopiesInlineElements) {
+  S21Matrix small = Pattern(3, 3, 2);
+  S21Matrix expected = small;
+  S21Matrix moved = std::move(small);
+
+  EXPECT_TRUE(moved == expected);
+  EXPECT_EQ(small.GetRows(), 0);
+
+  S21Matrix large = Pattern(5, 5, 4);
+  moved = std::move(large);
+  EXPECT_EQ(moved.GetRows(), 5);
+  EXPECT_EQ(moved(4, 4), Pattern(5, 5, 4)(4, 4));
+  small = std::move(moved);
+  EXPECT_EQ(small.GetRows(), 5);
+  EXPECT_EQ(moved.GetRows(), 0);
+}
+
+TEST(SmallMatrixTest, ResizeAcrossInlineLimit) {
+  S21Matrix matrix = Pattern(4, 4, 5);
+  S21Matrix expected = matrix;
+
+  matrix.SetRows(6);
+  matrix.SetCols(5);
+  for (int i = 0; i != 4; ++i) {
+    for (int j = 0; j != 4; ++j) EXPECT_EQ(matrix(i, j), expected(i, j));
+  }
+  EXPECT_EQ(matrix(5, 4), 0);
+
+  matrix.SetRows(4);
+  matrix.SetCols(4);
+  EXPECT_TRUE(matrix == expected);
+}
+
+TEST(ScalarTypesTest, FloatMatchesDouble) {
+  S21MatrixF a = Pattern<float>(70, 60, 2), b = Pattern<float>(60, 50, 5);
+  S21Matrix expected = Pattern(70, 60, 2) * Pattern(60, 50, 5);
+  S21MatrixF product = a * b + a * b * 0.5f;
+
+  static_assert(std::is_same<decltype(a * 2.0f)::value_type, float>::value,
+                "expressions keep the element type");
+  for (int i = 0; i != 70; ++i) {
+    for (int j = 0; j != 50; ++j) {
+      EXPECT_EQ(product(i, j), static_cast<float>(expected(i, j) * 1.5));
+    }
+  }
+}
+
+TEST(ScalarTypesTest, DeterminantAndInverse) {
+  S21MatrixF f = Pattern<float>(6, 6, 3);
+  S21MatrixLD ld = Pattern<long double>(6, 6, 3);
+  S21Matrix d = Pattern(6, 6, 3);
+  for (int i = 0; i != 6; ++i) {
+    f(i, i) += 10;
+    ld(i, i) += 10;
+    d(i, i) += 10;
+  }
+
+  EXPECT_NEAR(f.Determinant(), d.Determinant(), 1e-5 * d.Determinant());
+  EXPECT_NEAR(static_cast<double>(ld.Determinant()), d.Determinant(), 1e-6);
+
+  S21MatrixF identityF(6, 6);
+  S21MatrixLD identityLD(6, 6);
+  for (int i = 0; i != 6; ++i) identityF(i, i) = identityLD(i, i) = 1;
+  EXPECT_TRUE(f * f.InverseMatrix() == identityF);
+  EXPECT_TRUE(ld * ld.InverseMatrix() == identityLD);
+  EXPECT_EQ(S21MatrixF(3, 3).InverseMatrix().GetRows(), 0);
+}
+
+TEST(ScalarTypesTest, TolerancePerType) {
+  S21MatrixF f1(2, 2), f2(2, 2);
+  S21MatrixLD l1(2, 2), l2(2, 2);
+  S21Matrix d1(2, 2), d2(2, 2);
+  f2(1, 1) = 1e-5f;
+  d2(1, 1) = 1e-5;
+  l2(1, 1) = 1e-9L;
+
+  EXPECT_TRUE(f1 == f2);
+  EXPECT_FALSE(d1 == d2);
+  EXPECT_FALSE(l1 == l2);
+  l2(1, 1) = 1e-11L;
+  EXPECT_TRUE(l1 == l2);
+}
+
+TEST(MatrixViewTest, BlocksAndRanges) {
+  S21Matrix matrix = Pattern(6, 5, 3);
+  S21MatrixView block = matrix.Block(1, 2, 3, 2);
+  S21MatrixView rows = matrix.RowRange(4, 2);
+  S21MatrixView cols = matrix.ColRange(1, 3).Block(2, 1, 2, 2);
+
+  EXPECT_EQ(block.GetRows(), 3);
+  EXPECT_EQ(block.GetCols(), 2);
+  EXPECT_EQ(block(2, 1), matrix(3, 3));
+  EXPECT_EQ(rows(1, 4), matrix(5, 4));
+  EXPECT_EQ(cols(1, 0), matrix(3, 2));
+  EXPECT_EQ(S21Matrix(block).GetRows(), 3);
+  EXPECT_TRUE(S21Matrix(block) == block);
+
+  EXPECT_ANY_THROW(matrix.Block(4, 0, 3, 1));
+  EXPECT_ANY_THROW(matrix.ColRange(-1, 2));
+  EXPECT_ANY_THROW(block(3, 0));
+  EXPECT_ANY_THROW(matrix.Minor(0, 0).Block(0, 0, 1, 1));
+}
+
+TEST(MatrixViewTest, Minors) {
+  S21Matrix matrix = Pattern(6, 6, 4);
+  for (int i = 0; i != 6; ++i) matrix(i, i) += 5;
+
+  S21MatrixView minor = matrix.Minor(2, 3);
+  S21Matrix copy(5, 5);
+  for (int i = 0; i != 5; ++i) {
+    for (int j = 0; j != 5; ++j) {
+      copy(i, j) = matrix(i < 2 ? i : i + 1, j < 3 ? j : j + 1);
+    }
+  }
+
+  EXPECT_TRUE(minor == copy);
+  EXPECT_NEAR(minor.Determinant(), copy.Determinant(), 1e-6);
+  EXPECT_NEAR(copy.Minor(4, 0).Determinant(),
+              copy.Minor(4, 0).Transpose().Determinant(), 1e-7);
+  EXPECT_ANY_THROW(S21Matrix(1, 1).Minor(0, 0));
+}
+
+TEST(MatrixViewTest, ViewOperands) {
+  S21Matrix matrix = Pattern(8, 8, 2);
+  S21Matrix left = matrix.Block(0, 0, 3, 4);
+  S21Matrix right = matrix.Block(4, 4, 4, 2);
+
+  EXPECT_TRUE(matrix.Block(0, 0, 3, 4) * matrix.Block(4, 4, 4, 2) ==
+              left * right);
+  S21Matrix minor = matrix.Minor(7, 7), column = matrix.Block(0, 0, 7, 1);
+  EXPECT_TRUE(matrix.Minor(7, 7) * column == minor * column);
+
+  S21Matrix sum = left;
+  sum.SumMatrix(matrix.Block(0, 0, 3, 4));
+  EXPECT_TRUE(sum == left * 2.0);
+  sum.SubMatrix(matrix.RowRange(0, 3).ColRange(0, 4));
+  EXPECT_TRUE(sum.EqMatrix(matrix.Block(0, 0, 3, 4)));
+
+  // The destination of Gemm may overlap an operand view
+  S21Matrix expected =
+      matrix.ColRange(0, 4) * S21Matrix(matrix.ColRange(4, 4)).Transpose();
+  S21Matrix::Gemm(1, matrix.ColRange(0, 4), false, matrix.ColRange(4, 4),
+                  true, 0, matrix);
+  EXPECT_TRUE(matrix == expected);
+}
+
+TEST(MatrixViewTest, NoCopies) {
+  S21Matrix matrix = Pattern(40, 40, 3);
+
+  const long before = allocations;
+  S21MatrixView block = matrix.Block(10, 10, 4, 4);
+  const double det = block.Determinant();
+  const double corner = matrix.Minor(0, 0)(0, 0);
+  const bool equal = block == matrix.Block(10, 10, 4, 4);
+  EXPECT_EQ(allocations, before);
+
+  EXPECT_TRUE(equal);
+  EXPECT_EQ(det, S21Matrix(block).Determinant());
+  EXPECT_EQ(corner, matrix(1, 1));
+}
+
+// Pattern with only about one element in five left nonzero
+static S21Matrix SparsePattern(int rows, int cols, int seed) {
+  S21Matrix result = Pattern(rows, cols, seed);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      if ((i * seed + j) % 5 != 0) result(i, j) = 0;
+    }
+  }
+  return result;
+}
+
+TEST(SparseMatrixTest, TripletsAndDense) {
+  S21SparseMatrix sparse(3, 4, {{2, 1, 4.0}, {0, 3, 1.0}, {2, 1, -1.0},
+                                {1, 0, 5.0}, {0, 2, 2.0}, {1, 0, -5.0}});
+  EXPECT_EQ(sparse.GetNonZeros(), 3);
+  EXPECT_EQ(sparse.GetStarts(), std::vector<int>({0, 2, 2, 3}));
+  EXPECT_EQ(sparse.GetIndices(), std::vector<int>({2, 3, 1}));
+  EXPECT_EQ(sparse(2, 1), 3.0);
+  EXPECT_EQ(sparse(1, 0), 0.0);
+  EXPECT_THROW(sparse(3, 0), std::invalid_argument);
+  EXPECT_THROW(S21SparseMatrix(2, 2, {{0, 2, 1.0}}), std::invalid_argument);
+
+  S21Matrix dense = SparsePattern(9, 7, 3);
+  for (auto format : {S21SparseFormat::kCSR, S21SparseFormat::kCSC}) {
+    S21SparseMatrix converted(dense, format);
+    EXPECT_EQ(converted.GetFormat(), format);
+    EXPECT_TRUE(converted.ToDense() == dense);
+    EXPECT_TRUE(converted.ToFormat(S21SparseFormat::kCSR).ToDense() == dense);
+    EXPECT_TRUE(converted.ToFormat(S21SparseFormat::kCSC) == converted);
+  }
+}
+
+TEST(SparseMatrixTest, MulDense) {
+  S21Matrix a = SparsePattern(300, 200, 3);
+  S21Matrix b = Pattern(200, 70, 5);
+  S21Matrix expected = a * b;
+  S21SparseMatrix csr(a), csc(a, S21SparseFormat::kCSC);
+  EXPECT_TRUE(csr * b == expected);
+  EXPECT_TRUE(csr.MulDense(b, 1) == expected);
+  EXPECT_TRUE(csc * b == expected);
+  EXPECT_TRUE(csr * b.Transposed().Transposed() == expected);
+  EXPECT_TRUE(csr.MulDense(b.RowRange(0, 100)).GetRows() == 0);
+}
+
+TEST(SparseMatrixTest, MulSparse) {
+  S21Matrix a = SparsePattern(40, 30, 3);
+  S21Matrix b = SparsePattern(30, 50, 7);
+  S21Matrix expected = a * b;
+  for (auto lhs : {S21SparseFormat::kCSR, S21SparseFormat::kCSC}) {
+    for (auto rhs : {S21SparseFormat::kCSR, S21SparseFormat::kCSC}) {
+      S21SparseMatrix product =
+          S21SparseMatrix(a, lhs) * S21SparseMatrix(b, rhs);
+      EXPECT_EQ(product.GetFormat(), lhs);
+      EXPECT_TRUE(product.ToDense() == expected);
+    }
+  }
+  S21SparseMatrix wrong(a);
+  wrong *= S21SparseMatrix(a);
+  EXPECT_TRUE(wrong.ToDense() == a);
+}
+
+TEST(SparseMatrixTest, SumAndTranspose) {
+  S21Matrix a = SparsePattern(20, 30, 3);
+  S21Matrix b = SparsePattern(20, 30, 4);
+  S21SparseMatrix sa(a), sb(b, S21SparseFormat::kCSC);
+  EXPECT_TRUE((sa + sb).ToDense() == a + b);
+  EXPECT_TRUE((sa - sb).ToDense() == a - b);
+  EXPECT_TRUE((sa * 2.0).ToDense() == a * 2.0);
+
+  S21SparseMatrix zero = sa - sa;
+  EXPECT_EQ(zero.GetNonZeros(), 0);
+  EXPECT_TRUE(zero == S21SparseMatrix(20, 30));
+
+  S21SparseMatrix transposed = sa.Transpose();
+  EXPECT_EQ(transposed.GetRows(), 30);
+  EXPECT_EQ(transposed.GetFormat(), S21SparseFormat::kCSC);
+  EXPECT_TRUE(transposed.ToDense() == a.Transpose());
+  sa += transposed;
+  EXPECT_TRUE(sa.ToDense() == a);
+}
+
+TEST(PackedMatrixTest, Symmetric) {
+  S21Matrix a = Pattern(30, 12, 3);
+  S21Matrix gram = a.Transposed() * a;
+  S21SymmetricMatrix packed = S21SymmetricMatrix::Gram(a);
+  EXPECT_EQ(packed.GetSize(), 12);
+  EXPECT_TRUE(packed.ToDense() == gram);
+  EXPECT_TRUE(packed == S21SymmetricMatrix(gram));
+  EXPECT_EQ(packed(2, 7), packed(7, 2));
+
+  S21Matrix b = Pattern(12, 5, 4);
+  EXPECT_TRUE(packed * b == gram * b);
+  EXPECT_TRUE(packed * b.Transposed().Transposed() == gram * b);
+  EXPECT_EQ(packed.MulDense(a).GetRows(), 0);
+
+  packed(3, 1) = 100;
+  EXPECT_EQ(packed.ToDense()(1, 3), 100);
+  EXPECT_THROW(packed(12, 0), std::invalid_argument);
+  EXPECT_THROW(S21SymmetricMatrix(0), std::invalid_argument);
+}
+
+TEST(PackedMatrixTest, TriangularProducts) {
+  S21Matrix dense = Pattern(9, 9, 5);
+  for (S21Triangle triangle : {S21Triangle::kLower, S21Triangle::kUpper}) {
+    S21TriangularMatrix t(dense, triangle), u(dense.Transposed(), triangle);
+    S21Matrix td = t.ToDense(), ud = u.ToDense();
+    for (int i = 0; i < 9; i++) {
+      for (int j = 0; j < 9; j++) {
+        bool inside = triangle == S21Triangle::kLower ? j <= i : j >= i;
+        EXPECT_EQ(td(i, j), inside ? dense(i, j) : 0);
+      }
+    }
+    S21Matrix b = Pattern(9, 4, 2);
+    EXPECT_TRUE(t * b == td * b);
+    S21TriangularMatrix product = t;
+    product *= u;
+    EXPECT_TRUE(product.ToDense() == td * ud);
+    EXPECT_TRUE(t.Transpose().ToDense() == td.Transpose());
+    EXPECT_NE(t.Transpose().GetTriangle(), triangle);
+  }
+  S21TriangularMatrix lower(dense, S21Triangle::kLower);
+  S21TriangularMatrix upper(dense, S21Triangle::kUpper);
+  S21TriangularMatrix copy = lower;
+  copy += upper;
+  EXPECT_TRUE(copy == lower);
+  EXPECT_THROW(lower(0, 1) = 1, std::invalid_argument);
+  const S21TriangularMatrix &constLower = lower;
+  EXPECT_EQ(constLower(0, 1), 0);
+}
+
+TEST(PackedMatrixTest, TriangularSolveAndDeterminant) {
+  S21Matrix dense = Pattern(40, 40, 3);
+  for (int i = 0; i < 40; i++) dense(i, i) = 10 + i % 3;
+  S21Matrix b = Pattern(40, 3, 2);
+  for (S21Triangle triangle : {S21Triangle::kLower, S21Triangle::kUpper}) {
+    S21TriangularMatrix t(dense, triangle);
+    S21Matrix x = t.Solve(b);
+    EXPECT_TRUE(t * x == b);
+    EXPECT_NEAR(t.Determinant(), t.ToDense().Determinant(),
+                std::abs(t.Determinant()) * 1e-10);
+  }
+  S21TriangularMatrix singular(3);
+  EXPECT_EQ(singular.Determinant(), 0);
+  EXPECT_EQ(singular.Solve(S21Matrix(3, 1)).GetRows(), 0);
+  EXPECT_EQ(S21TriangularMatrix(4).Solve(b).GetRows(), 0);
+}
+
+TEST(PackedMatrixTest, TriangularSolveSmallDiagonal) {
+  S21Matrix dense(400, 400);
+  for (int i = 0; i < 400; i++) dense(i, i) = 0.1;
+  for (int i = 1; i < 400; i++) dense(i, i - 1) = 0.05;
+  const S21Matrix b = Pattern(400, 2, 1);
+  S21TriangularMatrix t(dense, S21Triangle::kLower);
+  EXPECT_EQ(t.Determinant(), 0);
+  S21Matrix x = t.Solve(b);
+  ASSERT_EQ(x.GetRows(), 400);
+  EXPECT_TRUE(t * x == b);
+}
+
+TEST(PackedMatrixTest, TriangularSolveNearZeroDiagonal) {
+  S21Matrix dense = Pattern(6, 6, 2);
+  for (int i = 0; i < 6; i++) dense(i, i) = 1;
+  dense(3, 3) = 1e-12;
+  for (S21Triangle triangle : {S21Triangle::kLower, S21Triangle::kUpper}) {
+    S21TriangularMatrix t(dense, triangle);
+    EXPECT_EQ(t.Solve(Pattern(6, 1, 1)).GetRows(), 0);
+    EXPECT_TRUE(S21LU(t.ToDense()).IsSingular());
+  }
+}
+
+TEST(BandMatrixTest, ConversionsAndProduct) {
+  S21Matrix dense = Pattern(10, 10, 3);
+  S21BandMatrix band(dense, 2, 1);
+  EXPECT_EQ(band.GetLower(), 2);
+  EXPECT_EQ(band.GetUpper(), 1);
+  S21Matrix expected = dense;
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 10; j++) {
+      if (j - i < -2 || j - i > 1) expected(i, j) = 0;
+    }
+  }
+  EXPECT_TRUE(band.ToDense() == expected);
+  EXPECT_TRUE(S21BandMatrix(expected, 3, 3) == band);
+
+  S21Matrix b = Pattern(10, 4, 5);
+  EXPECT_TRUE(band * b == expected * b);
+  EXPECT_EQ(band.MulDense(S21Matrix(3, 4)).GetRows(), 0);
+
+  const S21BandMatrix &constBand = band;
+  EXPECT_EQ(constBand(0, 5), 0);
+  EXPECT_THROW(band(0, 5) = 1, std::invalid_argument);
+  EXPECT_THROW(band(10, 0), std::invalid_argument);
+  EXPECT_THROW(S21BandMatrix(3, -1, 0), std::invalid_argument);
+}
+
+TEST(BandMatrixTest, TridiagonalSolve) {
+  const int n = 200;
+  std::vector<double> sub(n - 1, -1.0), diagonal(n, 2.0), super(n - 1, -1.0);
+  S21BandMatrix band = S21BandMatrix::Tridiagonal(sub, diagonal, super);
+  S21Matrix b = Pattern(n, 2, 3);
+  S21Matrix x = band.Solve(b);
+  EXPECT_TRUE(band * x == b);
+  EXPECT_NEAR(band.Determinant(), n + 1, 1e-7);
+  EXPECT_THROW(S21BandMatrix::Tridiagonal(sub, diagonal, {}),
+               std::invalid_argument);
+}
+
+TEST(BandMatrixTest, PivotingMatchesDense) {
+  S21Matrix dense = Pattern(12, 12, 5);
+  dense(0, 0) = 0;
+  S21BandMatrix band(dense, 2, 3);
+  S21Matrix full = band.ToDense();
+  S21BandLU lu(band);
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_NEAR(lu.Determinant(), full.Determinant(),
+              std::abs(full.Determinant()) * 1e-10);
+  S21Matrix b = Pattern(12, 3, 2);
+  EXPECT_TRUE(full * lu.Solve(b) == b);
+
+  S21BandMatrix singular(4, 1, 1);
+  EXPECT_EQ(singular.Determinant(), 0);
+  EXPECT_EQ(singular.Solve(S21Matrix(4, 1)).GetRows(), 0);
+  EXPECT_EQ(lu.Solve(S21Matrix(4, 1)).GetRows(), 0);
+}
+
+TEST(BandMatrixTest, RoundingSingular) {
+  // Row 1 is 3 times row 0, elimination leaves a pivot of rounding size
+  double matrix[3][3] = {{0.1, 0.2, 0}, {0.3, 0.6, 0}, {0, 0.7, 0.1}};
+  S21Matrix dense(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) dense(i, j) = matrix[i][j];
+  }
+  S21BandMatrix band(dense, 1, 1);
+  S21BandLU lu(band);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_TRUE(S21LU(dense).IsSingular());
+  EXPECT_EQ(lu.Determinant(), 0);
+  EXPECT_EQ(band.Solve(S21Matrix(3, 1)).GetRows(), 0);
+}
+
+// Gram matrix of a pattern plus a multiple of the identity, symmetric and
+// positive definite
+static S21Matrix PositiveDefinite(int size, int seed) {
+  S21Matrix a = Pattern(size + 3, size, seed);
+  S21Matrix result = a.Transposed() * a;
+  for (int i = 0; i < size; i++) result(i, i) += size;
+  return result;
+}
+
+static S21Matrix Identity(int size) {
+  S21Matrix result(size, size);
+  for (int i = 0; i < size; i++) result(i, i) = 1;
+  return result;
+}
+
+TEST(CholeskyTest, SolveAndInverse) {
+  for (int size : {5, 150}) {
+    S21Matrix a = PositiveDefinite(size, 3);
+    S21Cholesky cholesky(a);
+    EXPECT_TRUE(cholesky.IsPositiveDefinite());
+    EXPECT_EQ(cholesky.GetSize(), size);
+    S21Matrix b = Pattern(size, 3, 2);
+    EXPECT_TRUE(a * cholesky.Solve(b) == b);
+    EXPECT_TRUE(a * cholesky.Inverse() == Identity(size));
+  }
+  S21Matrix small = PositiveDefinite(8, 5);
+  EXPECT_NEAR(S21Cholesky(small).LogDeterminant(),
+              std::log(S21LU(small).Determinant()), 1e-9);
+}
+
+TEST(CholeskyTest, NotPositiveDefinite) {
+  S21Matrix a = PositiveDefinite(100, 3);
+  a(90, 90) = -1;
+  S21Cholesky cholesky(a);
+  EXPECT_FALSE(cholesky.IsPositiveDefinite());
+  EXPECT_EQ(cholesky.Solve(Pattern(100, 1, 2)).GetRows(), 0);
+  EXPECT_TRUE(std::isnan(cholesky.LogDeterminant()));
+  EXPECT_EQ(S21Cholesky(a).Solve(Pattern(3, 1, 2)).GetRows(), 0);
+  EXPECT_THROW(S21Cholesky(Pattern(3, 4, 1)), std::invalid_argument);
+}
+
+TEST(CholeskyTest, SymmetricInverse) {
+  S21Matrix a = PositiveDefinite(30, 4);
+  EXPECT_TRUE(a.IsSymmetric());
+  EXPECT_TRUE(a * a.InverseMatrix() == Identity(30));
+  a(0, 7) += 1;
+  EXPECT_FALSE(a.IsSymmetric());
+  EXPECT_TRUE(a * a.InverseMatrix() == Identity(30));
+  S21Matrix indefinite = a.Transposed() + a;
+  indefinite(0, 0) = -100;
+  EXPECT_TRUE(indefinite.IsSymmetric());
+  EXPECT_TRUE(indefinite * indefinite.InverseMatrix() == Identity(30));
+  EXPECT_FALSE(Pattern(3, 4, 1).IsSymmetric());
+}
+
+TEST(CholeskyTest, IndefiniteInverse) {
+  // Positive diagonal, but rows i and i + 50 couple with eigenvalues 5 and
+  // -1, the trailing pivots go negative after the first panel
+  S21Matrix coupled(100, 100);
+  for (int i = 0; i < 50; i++) {
+    coupled(i, i) = coupled(i + 50, i + 50) = 2;
+    coupled(i, i + 50) = coupled(i + 50, i) = 3;
+  }
+  EXPECT_FALSE(S21Cholesky(coupled).IsPositiveDefinite());
+  EXPECT_TRUE(coupled * coupled.InverseMatrix() == Identity(100));
+
+  // Saddle point system [H B^T; B 0] with a zero block on the diagonal
+  S21Matrix h = PositiveDefinite(8, 2), b = Pattern(3, 8, 5);
+  S21Matrix kkt(11, 11);
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 8; j++) kkt(i, j) = h(i, j);
+    for (int j = 0; j < 3; j++) kkt(8 + j, i) = kkt(i, 8 + j) = b(j, i);
+  }
+  EXPECT_TRUE(kkt.IsSymmetric());
+  EXPECT_FALSE(S21Cholesky(kkt).IsPositiveDefinite());
+  EXPECT_TRUE(kkt * kkt.InverseMatrix() == Identity(11));
+}
+
+TEST(CholeskyTest, NearlySymmetricInverse) {
+  S21Matrix a(5, 5);
+  for (int i = 0; i < 5; i++) a(i, i) = 1e-3;
+  a(1, 0) = 5e-8;
+  EXPECT_TRUE(a.IsSymmetric());
+  const S21Matrix inverse = a.InverseMatrix();
+  EXPECT_NEAR(inverse(0, 1), 0, 1e-12);
+  EXPECT_NEAR(inverse(1, 0), -0.05, 1e-9);
+  EXPECT_NEAR(inverse(0, 0), 1e3, 1e-9);
+}
+
+// Tall pattern with a dominant diagonal on top, of full column rank
+static S21Matrix TallFullRank(int rows, int cols, int seed) {
+  S21Matrix result = Pattern(rows, cols, seed);
+  for (int i = 0; i < cols; i++) result(i, i) += 10;
+  return result;
+}
+
+TEST(QRTest, FactorR) {
+  for (int cols : {6, 80}) {
+    S21Matrix a = TallFullRank(300, cols, 3);
+    S21QR qr(a);
+    EXPECT_EQ(qr.GetRows(), 300);
+    EXPECT_EQ(qr.GetCols(), cols);
+    EXPECT_TRUE(qr.IsFullRank());
+    // A = Q * R with an orthogonal Q, so A^T * A = R^T * R
+    S21Matrix r = qr.GetR();
+    EXPECT_TRUE(r.Transposed() * r == a.Transposed() * a);
+    for (int i = 0; i < cols; i++) {
+      for (int j = 0; j < i; j++) EXPECT_EQ(r(i, j), 0);
+    }
+  }
+}
+
+TEST(QRTest, LeastSquares) {
+  for (int cols : {6, 70}) {
+    S21Matrix a = TallFullRank(200, cols, 5);
+    S21Matrix b = Pattern(200, 2, 4);
+    S21Matrix x = S21QR::LeastSquares(a, b);
+    EXPECT_EQ(x.GetRows(), cols);
+    // The residual of a least-squares solution is orthogonal to A
+    S21Matrix residual = a * x - b;
+    EXPECT_TRUE(a.Transposed() * residual == S21Matrix(cols, 2));
+    S21Matrix normal = (a.Transposed() * a).InverseMatrix();
+    EXPECT_TRUE(x == normal * (a.Transposed() * b));
+  }
+  S21Matrix square = TallFullRank(40, 40, 3);
+  S21Matrix b = Pattern(40, 1, 2);
+  EXPECT_TRUE(square * S21QR(square).Solve(b) == b);
+}
+
+TEST(QRTest, RankDeficientAndWrongSizes) {
+  S21Matrix a = TallFullRank(20, 4, 3);
+  for (int i = 0; i < 20; i++) a(i, 3) = a(i, 0) * 2;
+  S21QR qr(a);
+  EXPECT_FALSE(qr.IsFullRank());
+  EXPECT_EQ(qr.Solve(Pattern(20, 1, 2)).GetRows(), 0);
+  EXPECT_EQ(S21QR(TallFullRank(20, 4, 3)).Solve(Pattern(5, 1, 2)).GetRows(), 0);
+  EXPECT_THROW(S21QR(Pattern(3, 4, 1)), std::invalid_argument);
+}
+
+TEST(ScratchArenaTest, ScopesRewind) {
+  S21ScratchArena &arena = S21ScratchArena::Local();
+  arena.Release();
+  {
+    S21ScratchScope outer;
+    double *first = arena.Allocate<double>(10);
+    {
+      S21ScratchScope inner;
+      arena.Allocate<double>(1 << 17);
+    }
+    double *second = arena.Allocate<double>(10);
+    EXPECT_EQ(second, first + 16);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) %
+                  S21ScratchArena::kAlignment,
+              0u);
+  }
+  EXPECT_GE(arena.GetCapacity(), sizeof(double) << 17);
+
+  const long before = allocations;
+  {
+    S21ScratchScope scope;
+    arena.Allocate<double>(10);
+    arena.Allocate<double>(1 << 17);
+  }
+  EXPECT_EQ(allocations, before);
+  arena.Release();
+  EXPECT_EQ(arena.GetCapacity(), 0u);
+}
+
+TEST(ScratchArenaTest, OperationsAllocateOnlyTheirResults) {
+  S21Matrix general = Pattern(9, 9, 2), spd = PositiveDefinite(9, 1);
+  for (int i = 0; i < 9; i++) general(i, i) += 20;
+  // Warm-up sizes the arena for every operation
+  general.CalcComplements();
+  general.InverseMatrix();
+  spd.InverseMatrix();
+
+  long before = allocations;
+  const double det = general.Determinant();
+  EXPECT_EQ(allocations, before);
+  S21Matrix complements = general.CalcComplements();
+  S21Matrix inverse = general.InverseMatrix();
+  S21Matrix spdInverse = spd.InverseMatrix();
+  EXPECT_EQ(allocations - before, 3);
+
+  EXPECT_TRUE(general * inverse == Identity(9));
+  EXPECT_TRUE(spd * spdInverse == Identity(9));
+  EXPECT_TRUE(complements.Transpose() * (1 / det) == inverse);
+}
+
+TEST(ScratchArenaTest, FactorizationTemporaries) {
+  S21Matrix a = PositiveDefinite(150, 2), tall = TallFullRank(200, 70, 3);
+  S21Cholesky warmCholesky(a);
+  S21QR warmQR(tall);
+
+  long before = allocations;
+  S21Cholesky cholesky(a);
+  EXPECT_EQ(allocations - before, 1);
+  // R with the reflectors, tau and the S factors of the three panels
+  before = allocations;
+  S21QR qr(tall);
+  EXPECT_EQ(allocations - before, 6);
+
+  EXPECT_NEAR(cholesky.LogDeterminant(), warmCholesky.LogDeterminant(), 1e-9);
+  EXPECT_TRUE(qr.GetR() == warmQR.GetR());
+}
+
+TEST(ScratchArenaTest, PackedProducts) {
+  S21Matrix a = Pattern(160, 150, 3), wide = Pattern(160, 20, 4);
+  S21Matrix gram = a.Transposed() * a;
+  S21SymmetricMatrix packed(gram);
+  S21TriangularMatrix lower(gram, S21Triangle::kLower);
+  S21TriangularMatrix upper(gram, S21Triangle::kUpper);
+  // Rows 5..154 of the wide matrix, so every operand is strided
+  S21MatrixView b = wide.Block(5, 3, 150, 12);
+  packed * b;
+  lower * b;
+
+  long before = allocations;
+  S21Matrix product = packed * b;
+  S21Matrix lowerProduct = lower * b;
+  S21Matrix upperProduct = upper * b;
+  EXPECT_EQ(allocations - before, 3);
+
+  S21Matrix dense = b;
+  EXPECT_TRUE(product == gram * dense);
+  EXPECT_TRUE(lowerProduct == lower.ToDense() * dense);
+  EXPECT_TRUE(upperProduct == upper.ToDense() * dense);
+  EXPECT_TRUE(packed * dense.Transposed().Transposed() == product);
 }
 
 int main(int argc, char **argv) {